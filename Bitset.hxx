@@ -16,17 +16,26 @@ class Bitset {
 	// TODO: Support zero-sized bitsets?
 
 	using size_type = STD::size_t;
+	using _word_type = STD::uint64_t;
 
-	static constexpr auto _bits_per_chunk = 64;
-	Array<STD::uint64_t, (N+_bits_per_chunk-1)/_bits_per_chunk> _storage;
+	static constexpr size_type _bits_per_chunk = 64;
+	static constexpr size_type _chunks = (N+_bits_per_chunk-1)/_bits_per_chunk;
+	Array<_word_type, _chunks> _storage;
 
 	constexpr decltype(auto) _chunkof(size_type i)       {return _storage[i/_bits_per_chunk];}
 	constexpr decltype(auto) _chunkof(size_type i) const {return _storage[i/_bits_per_chunk];}
 
-	CONSTAINER_PURE_CONST static constexpr STD::uint64_t _mask_chunkof(size_type i) {
+	CONSTAINER_PURE_CONST static constexpr _word_type _mask_chunkof(size_type i) {
 		return 1ull << i%_bits_per_chunk;
 	}
-	static constexpr STD::uint64_t _full_mask = -1;
+	static constexpr _word_type _full_mask = -1;
+	// The bits of the last chunk that are part of the set.
+	static constexpr _word_type _last_mask = N%_bits_per_chunk == 0? _full_mask : _mask_chunkof(N)-1;
+
+	/**< The bits [lo, hi] of a chunk, where lo <= hi < _bits_per_chunk. */
+	CONSTAINER_PURE_CONST static constexpr _word_type _range_mask(size_type lo, size_type hi) {
+		return (_full_mask >> (_bits_per_chunk-1 - hi)) & (_full_mask << lo);
+	}
 
 	constexpr void _flip (size_type pos) {
 		_chunkof(pos) ^= _mask_chunkof(pos);
@@ -42,9 +51,39 @@ class Bitset {
 	}
 
 	constexpr void _nullify_trailbits() {
-		_storage.back() &= _mask_chunkof(size()) - 1;
+		_storage.back() &= _last_mask;
 	}
 
+	/**< Chunk i, inverted if we search for zeroes. Bits past the end are zero either way. */
+	constexpr _word_type _chunk_for(size_type i, bool value) const {
+		auto c = value? _storage[i] : ~_storage[i];
+		return i == _chunks-1? c & _last_mask : c;
+	}
+
+	/**< Calls op(chunk, mask) for every chunk of storage that intersects the bits [pos1, pos2], where mask selects
+	     the bits of that chunk that lie in the range. Inner chunks are processed as whole words. */
+	template <typename Storage, typename Op>
+	static constexpr void _for_range(Storage& storage, size_type pos1, size_type pos2, Op op) {
+		assert(pos1 <= pos2 && pos2 < N);
+		auto first = pos1/_bits_per_chunk, last = pos2/_bits_per_chunk;
+		auto lo = pos1%_bits_per_chunk, hi = pos2%_bits_per_chunk;
+		if (first == last) {
+			op(storage[first], _range_mask(lo, hi));
+			return;
+		}
+		op(storage[first], _range_mask(lo, _bits_per_chunk-1));
+		for (auto i = first+1; i != last; ++i)
+			op(storage[i], _full_mask);
+		op(storage[last], _range_mask(0, hi));
+	}
+
+	struct _SetOp   {constexpr void operator()(_word_type& c, _word_type m) const {c |= m;}};
+	struct _ResetOp {constexpr void operator()(_word_type& c, _word_type m) const {c &= ~m;}};
+	struct _FlipOp  {constexpr void operator()(_word_type& c, _word_type m) const {c ^= m;}};
+	struct _CountOp {
+		size_type& count;
+		constexpr void operator()(_word_type const& c, _word_type m) const {count += popcount(c & m);}
+	};
 
 public:
 
@@ -83,12 +122,17 @@ public:
 	constexpr size_type size() const {return N;}
 
 	constexpr bool none() const {
-		return Constainer::find(begin(_storage), end(_storage), 0, STD::not_equal_to<>()) == end(_storage);
+		_word_type acc = 0;
+		for (auto c : _storage)
+			acc |= c;
+		return acc == 0;
 	}
 	constexpr bool any() const {return !none();}
 	constexpr bool all() const {
-		return Constainer::find(begin(_storage), end(_storage)-1, _full_mask, STD::not_equal_to<>()) == end(_storage)-1
-		    && _storage.back() + 1 == _mask_chunkof(size());
+		_word_type acc = _full_mask;
+		for (size_type i = 0; i != _chunks-1; ++i)
+			acc &= _storage[i];
+		return acc == _full_mask && _storage.back() == _last_mask;
 	}
 
 	constexpr Bitset() : _storage{} {}
@@ -104,9 +148,15 @@ public:
 			ret += popcount(c);
 		return ret;
 	}
+	/**< The number of set bits in [pos1, pos2]. */
+	constexpr size_type count(size_type pos1, size_type pos2) const {
+		size_type ret = 0;
+		_for_range(_storage, pos1, pos2, _CountOp{ret});
+		return ret;
+	}
 
 	constexpr Bitset& set() {
-		_storage.fill( _mask_chunkof(_bits_per_chunk-1)-1 );
+		_storage.fill(_full_mask);
 		_nullify_trailbits();
 		return *this;
 	}
@@ -115,10 +165,12 @@ public:
 		_set(pos, value);
 		return *this;
 	}
+	/**< Sets the bits [pos1, pos2] to value. */
 	constexpr Bitset& set(size_type pos1, size_type pos2, bool value = true) {
-	    // TODO: This can be made a good lot more efficient, and you know how.
-		while (pos1 != pos2+1)
-            set(pos1++, value);
+		if (value)
+			_for_range(_storage, pos1, pos2, _SetOp{});
+		else
+			_for_range(_storage, pos1, pos2, _ResetOp{});
 		return *this;
 	}
 
@@ -133,6 +185,10 @@ public:
 		_flip(pos);
 		return *this;
 	}
+	constexpr Bitset& flip(size_type pos1, size_type pos2) {
+		_for_range(_storage, pos1, pos2, _FlipOp{});
+		return *this;
+	}
 
 	constexpr Bitset& reset() {
 		Constainer::fill(Constainer::begin(_storage), Constainer::end(_storage), 0);
@@ -143,16 +199,81 @@ public:
 		_reset(pos);
 		return *this;
 	}
+	constexpr Bitset& reset(size_type pos1, size_type pos2) {
+		return set(pos1, pos2, false);
+	}
 
+	/**< The position of the first bit that equals value, or size() if there is none. */
+	constexpr size_type find_first(bool value = true) const {
+		for (size_type i = 0; i != _chunks; ++i)
+			if (auto c = _chunk_for(i, value))
+				return i*_bits_per_chunk + count_trailing(c);
+		return size();
+	}
+	/**< The position of the first bit after pos that equals value, or size() if there is none. */
+	constexpr size_type find_next(size_type pos, bool value = true) const {
+		if (++pos >= size())
+			return size();
+		auto i = pos/_bits_per_chunk;
+		auto c = _chunk_for(i, value) & (_full_mask << pos%_bits_per_chunk);
+		while (c == 0)
+			if (++i == _chunks)
+				return size();
+			else
+				c = _chunk_for(i, value);
+		return i*_bits_per_chunk + count_trailing(c);
+	}
+	/**< The position of the last bit that equals value, or size() if there is none. */
+	constexpr size_type find_last(bool value = true) const {
+		for (size_type i = _chunks; i-- != 0;)
+			if (auto c = _chunk_for(i, value))
+				return i*_bits_per_chunk + _bits_per_chunk-1 - count_leading(c);
+		return size();
+	}
+
+	/**< The number of leading (i.e. least significant) bits that equal value. */
 	constexpr size_type leading(bool value) const {
-		STD::size_t count = 0;
-		for (auto& c : _storage) {
-			auto v = value? ~c : c;
-			if (v != 0)
-				return STD::min<size_type>(size(), count++*_bits_per_chunk + count_trailing(v));
-		}
+		return find_first(!value);
+	}
 
-		return size();
+	/**< Moves bit i to i+n, like STD::bitset. */
+	constexpr Bitset& operator<<=(size_type n) {
+		if (n >= size())
+			return reset();
+		auto shift = n/_bits_per_chunk, offset = n%_bits_per_chunk;
+		for (auto i = _chunks; i-- != shift;) {
+			_storage[i] = _storage[i-shift] << offset;
+			if (offset != 0 && i != shift)
+				_storage[i] |= _storage[i-shift-1] >> (_bits_per_chunk-offset);
+		}
+		Constainer::fill_n(_storage.begin(), shift, 0);
+		_nullify_trailbits();
+		return *this;
+	}
+	/**< Moves bit i to i-n. */
+	constexpr Bitset& operator>>=(size_type n) {
+		if (n >= size())
+			return reset();
+		auto shift = n/_bits_per_chunk, offset = n%_bits_per_chunk;
+		for (size_type i = 0; i != _chunks-shift; ++i) {
+			_storage[i] = _storage[i+shift] >> offset;
+			if (offset != 0 && i+shift+1 != _chunks)
+				_storage[i] |= _storage[i+shift+1] << (_bits_per_chunk-offset);
+		}
+		Constainer::fill(_storage.end()-shift, _storage.end(), 0);
+		return *this;
+	}
+	constexpr Bitset operator<<(size_type n) const {
+		auto rval = *this;
+		return rval <<= n;
+	}
+	constexpr Bitset operator>>(size_type n) const {
+		auto rval = *this;
+		return rval >>= n;
+	}
+	constexpr Bitset operator~() const {
+		auto rval = *this;
+		return rval.flip();
 	}
 
 	template <typename CharT = char, STD::size_t MaxN = N,
@@ -160,10 +281,9 @@ public:
 	constexpr BasicString<CharT, MaxN, CharTraits> to_string(CharT zero='0', CharT one='1') const
 	{
 		BasicString<CharT, MaxN, CharTraits> str; str.resize(size(), zero);
-		// TODO: More efficient?
-		for (size_type i = 0; i != size(); ++i)
-			if (test(i))
-				CharTraits::assign(str[i], one);
+		for (size_type i = 0; i != _chunks; ++i)
+			for (auto c = _storage[i]; c != 0; c &= c-1)
+				CharTraits::assign(str[i*_bits_per_chunk + count_trailing(c)], one);
 		return str;
 	}
 
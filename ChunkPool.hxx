@@ -5,10 +5,59 @@
 #pragma once
 
 #include "Array.hxx"
+#include "Assert.hxx"
 #include "Bitset.hxx"
 
+#include <cstdint>
+#include <new>
+
 namespace Constainer {
 
+namespace detail {
+	/**< Hands out the indices [0, N) in O(1). Indices that have never been grabbed since the last reset are taken
+	     from a watermark, freed indices are kept on a stack and reused first. The bitset only serves to verify
+	     that freed indices are in use. */
+	template <STD::size_t N>
+	class SlotAllocator {
+	public:
+		using size_type = STD::size_t;
+
+	private:
+		using _index_type = STD::conditional_t<(N <= 0xFF),   STD::uint8_t,
+		                    STD::conditional_t<(N <= 0xFFFF), STD::uint16_t, STD::uint32_t>>;
+
+		Array<_index_type, N> _free_list{};
+		size_type _free_count = 0;
+		size_type _watermark = 0;
+		Bitset<N> _used{};
+
+	public:
+		static constexpr size_type max_size() {return N;}
+
+		constexpr size_type used() const {return _watermark - _free_count;}
+		constexpr size_type available() const {return max_size() - used();}
+
+		constexpr bool test(size_type i) const {return _used.test(i);}
+
+		constexpr size_type grab() {
+			AssertExcept<STD::bad_alloc>( available() != 0 );
+			auto i = _free_count != 0? _free_list[--_free_count] : _watermark++;
+			_used.set(i);
+			return i;
+		}
+
+		constexpr void free() {
+			_used.reset();
+			_free_count = _watermark = 0;
+		}
+		constexpr void free(size_type i) {
+			assert( _used.test(i) );
+			_used.reset(i);
+			_free_list[_free_count++] = i;
+		}
+	};
+}
+
 template <typename T, STD::size_t N>
 class ChunkPool : private Array<T, N> {
 
@@ -29,36 +78,50 @@ public:
 	static constexpr size_type max_size() {return _base::size();}
 
 private:
-	Bitset<N> _used;
+	detail::SlotAllocator<N> _slots;
+
+	constexpr pointer _grab() {
+		auto& ref = _base::operator[](_slots.grab());
+		ref = value_type();
+		return &ref;
+	}
 
 public:
 
-	constexpr ChunkPool() : _base{}, _used{} {}
+	constexpr ChunkPool() : _base{}, _slots{} {}
 
 	constexpr size_type used() const {
-		return _used.count();
+		return _slots.used();
 	}
 
 	constexpr bool available() const {
-		return !_used.all();
+		return _slots.available() != 0;
 	}
 
 	constexpr pointer grab() {
-		auto pos = _used.leading(1);
-		AssertExcept<STD::bad_alloc>(pos != this->size());
-		_used.set(pos);
-		auto& ref = _base::operator[](pos);
-		ref = value_type();
-		return &ref;
+		return _grab();
+	}
+	/**< Grabs n chunks at once and writes pointers to them to out. Either all chunks are grabbed or none. */
+	template <typename OutputIt>
+	constexpr OutputIt grab_n(size_type n, OutputIt out) {
+		AssertExcept<STD::bad_alloc>( n <= _slots.available() );
+		while (n--)
+			*out++ = _grab();
+		return out;
 	}
 
 	constexpr void free() {
-		_used.reset();
+		_slots.free();
 	}
 	constexpr void free( const_pointer p ) {
-		auto i = p-_base::data();
-		assert( _used.test(i) );
-		_used.reset(i);
+		_slots.free(p-_base::data());
+	}
+	/**< Frees the n chunks pointed to by [first, first+n). */
+	template <typename InputIt>
+	constexpr InputIt free_n(InputIt first, size_type n) {
+		while (n--)
+			free(*first++);
+		return first;
 	}
 };
 
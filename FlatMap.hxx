@@ -14,7 +14,7 @@ namespace Constainer {
 	class ConstKeyPair : public TotallyOrdered<ConstKeyPair<Key, Value>> {
 		using _base = STD::tuple<Key, Value>;
 
-		Key _key; Value _value;
+		Key _key{}; Value _value{};
 
 		template <typename, typename>
 		friend class ConstKeyPair;
@@ -88,12 +88,10 @@ public:
 		constexpr value_type      && value()      && {return STD::move(_value);}
 		constexpr value_type const&& value() const&& {return STD::move(_value);}
 
-		template <typename K, typename V>
-		friend constexpr bool operator==(ConstKeyPair<K, V> const& lhs, ConstKeyPair<K, V> const& rhs) {
+		friend constexpr bool operator==(ConstKeyPair const& lhs, ConstKeyPair const& rhs) {
 			return lhs.key() == rhs.key() && lhs.value() == rhs.value();
 		}
-		template <typename K, typename V>
-		friend constexpr bool operator <(ConstKeyPair<K, V> const& lhs, ConstKeyPair<K, V> const& rhs) {
+		friend constexpr bool operator <(ConstKeyPair const& lhs, ConstKeyPair const& rhs) {
 			return lhs.key()<rhs.key() || lhs.value()<rhs.value();
 		}
 	};
@@ -117,12 +115,12 @@ namespace Constainer {
 
 namespace detail {
 template <typename Key, typename Mapped, typename Compare, typename Container,
-          template <typename...> class Base>
+          template <typename...> class Base, typename Layout = BinarySearchLayout>
 class BasicFlatMap
 	: public      Base<Key, ConstKeyPair<Key, Mapped>,
-	                   typename ConstKeyPair<Key, Mapped>::KeyOfPair, Compare, Container> {
+	                   typename ConstKeyPair<Key, Mapped>::KeyOfPair, Compare, Container, Layout> {
 	using _base = Base<Key, ConstKeyPair<Key, Mapped>,
-	                   typename ConstKeyPair<Key, Mapped>::KeyOfPair, Compare, Container>;
+	                   typename ConstKeyPair<Key, Mapped>::KeyOfPair, Compare, Container, Layout>;
 
 public:
 	using _base::_base;
@@ -224,19 +222,23 @@ public:
 };
 }
 
-template <typename K, typename M, typename C, typename Cont>
-using BasicFlatMap = detail::BasicFlatMap<K, M, C, Cont, detail::FlatUniqueTree>;
-template <typename K, typename M, typename C, typename Cont>
-using BasicFlatMultiMap = detail::BasicFlatMap<K, M, C, Cont, detail::FlatMultiTree>;
-
-template <typename K, typename V, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<K>>
-using FlatMap = BasicFlatMap<K, V, Compare, Constainer::Vector<ConstKeyPair<K, V>, MaxN>>;
-template <typename K, typename V, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<K>>
-using StableFlatMap = BasicFlatMap<K, V, Compare, Constainer::StableVector<ConstKeyPair<K, V>, MaxN>>;
-
-template <typename K, typename V, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<K>>
-using FlatMultiMap = BasicFlatMultiMap<K, V, Compare, Constainer::Vector<ConstKeyPair<K, V>, MaxN>>;
-template <typename K, typename V, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<K>>
-using StableFlatMultiMap = BasicFlatMultiMap<K, V, Compare, Constainer::StableVector<ConstKeyPair<K, V>, MaxN>>;
+template <typename K, typename M, typename C, typename Cont, typename Layout = BinarySearchLayout>
+using BasicFlatMap = detail::BasicFlatMap<K, M, C, Cont, detail::FlatUniqueTree, Layout>;
+template <typename K, typename M, typename C, typename Cont, typename Layout = BinarySearchLayout>
+using BasicFlatMultiMap = detail::BasicFlatMap<K, M, C, Cont, detail::FlatMultiTree, Layout>;
+
+template <typename K, typename V, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<K>,
+          typename Layout = BinarySearchLayout>
+using FlatMap = BasicFlatMap<K, V, Compare, Constainer::Vector<ConstKeyPair<K, V>, MaxN>, Layout>;
+template <typename K, typename V, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<K>,
+          typename Layout = BinarySearchLayout>
+using StableFlatMap = BasicFlatMap<K, V, Compare, Constainer::StableVector<ConstKeyPair<K, V>, MaxN>, Layout>;
+
+template <typename K, typename V, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<K>,
+          typename Layout = BinarySearchLayout>
+using FlatMultiMap = BasicFlatMultiMap<K, V, Compare, Constainer::Vector<ConstKeyPair<K, V>, MaxN>, Layout>;
+template <typename K, typename V, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<K>,
+          typename Layout = BinarySearchLayout>
+using StableFlatMultiMap = BasicFlatMultiMap<K, V, Compare, Constainer::StableVector<ConstKeyPair<K, V>, MaxN>, Layout>;
 
 }
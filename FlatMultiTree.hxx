@@ -9,10 +9,11 @@
 
 namespace Constainer { namespace detail {
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare, typename Container>
+template <typename Key, typename Value, typename KeyOfValue, typename Compare, typename Container,
+          typename Layout = BinarySearchLayout>
 class FlatMultiTree
-	: public      FlatTree<Key, Value, KeyOfValue, Compare, Container> {
-	using _base = FlatTree<Key, Value, KeyOfValue, Compare, Container>;
+	: public      FlatTree<Key, Value, KeyOfValue, Compare, Container, Layout> {
+	using _base = FlatTree<Key, Value, KeyOfValue, Compare, Container, Layout>;
 
 	using typename _base::_iter_pair;
 	using typename _base::_const_iter_pair;
@@ -24,6 +25,8 @@ class FlatMultiTree
 	using _base::emplace_hint_equal;
 	using _base::emplace_unique;
 	using _base::emplace_hint_unique;
+	using _base::merge_unique;
+	using _base::merge_equal;
 
 public:
 
@@ -94,6 +97,11 @@ public:
 		insert(ordered_range, ilist.begin(), ilist.end());
 	}
 
+	template <typename Source>
+	constexpr void merge(Source const& source) {
+		_base::merge_equal(source);
+	}
+
 	template <typename... Args>
 	constexpr STD::pair<iterator, bool> emplace(Args&&... args) {
 		return this->emplace_equal(STD::forward<Args>(args)...);
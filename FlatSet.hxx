@@ -10,20 +10,24 @@
 
 namespace Constainer {
 
-template <typename Key, typename Compare, typename Container>
-using BasicFlatSet = detail::FlatUniqueTree<Key, Key, IdentityFunctor, Compare, Container>;
-
-template <typename T, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<T>>
-using FlatSet = BasicFlatSet<T, Compare, Constainer::Vector<T, MaxN>>;
-template <typename T, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<T>>
-using StableFlatSet = BasicFlatSet<T, Compare, Constainer::StableVector<T, MaxN>>;
-
-template <typename Key, typename Compare, typename Container>
-using BasicFlatMultiSet = detail::FlatMultiTree<Key, Key, IdentityFunctor, Compare, Container>;
-
-template <typename T, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<T>>
-using FlatMultiSet       = BasicFlatMultiSet<T, Compare, Constainer::Vector<T, MaxN>>;
-template <typename T, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<T>>
-using StableFlatMultiSet = BasicFlatMultiSet<T, Compare, Constainer::StableVector<T, MaxN>>;
+template <typename Key, typename Compare, typename Container, typename Layout = BinarySearchLayout>
+using BasicFlatSet = detail::FlatUniqueTree<Key, Key, IdentityFunctor, Compare, Container, Layout>;
+
+template <typename T, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<T>,
+          typename Layout = BinarySearchLayout>
+using FlatSet = BasicFlatSet<T, Compare, Constainer::Vector<T, MaxN>, Layout>;
+template <typename T, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<T>,
+          typename Layout = BinarySearchLayout>
+using StableFlatSet = BasicFlatSet<T, Compare, Constainer::StableVector<T, MaxN>, Layout>;
+
+template <typename Key, typename Compare, typename Container, typename Layout = BinarySearchLayout>
+using BasicFlatMultiSet = detail::FlatMultiTree<Key, Key, IdentityFunctor, Compare, Container, Layout>;
+
+template <typename T, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<T>,
+          typename Layout = BinarySearchLayout>
+using FlatMultiSet       = BasicFlatMultiSet<T, Compare, Constainer::Vector<T, MaxN>, Layout>;
+template <typename T, STD::size_t MaxN=defaultContainerSize, typename Compare = STD::less<T>,
+          typename Layout = BinarySearchLayout>
+using StableFlatMultiSet = BasicFlatMultiSet<T, Compare, Constainer::StableVector<T, MaxN>, Layout>;
 
 }
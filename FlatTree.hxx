@@ -9,7 +9,9 @@
 
 #include "Algorithms.hxx"
 #include "Operators.hxx"
+#include "SearchLayout.hxx"
 #include "Vector.hxx"
+#include "impl/OperationCounts.hxx"
 
 #include <type_traits>
 
@@ -26,6 +28,7 @@ namespace detail {
 		constexpr ValueComparator(Compare const& comp) : Compare(comp) {}
 
 		constexpr bool operator()(Value const& lhs, Value const& rhs) const {
+			countOperations(&OperationCounts::comparisons, 1);
 			return Compare::operator()(KeyOfValue()(lhs), KeyOfValue()(rhs));
 		}
 	};
@@ -41,11 +44,28 @@ namespace detail {
 		constexpr ValueComparator(Compare const& comp) : _comp(comp) {}
 
 		constexpr bool operator()(Value const& lhs, Value const& rhs) const {
+			countOperations(&OperationCounts::comparisons, 1);
 			return _comp(KeyOfValue()(lhs), KeyOfValue()(rhs));
 		}
 	};
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare, typename Container>
+	/**< Forwards to a key comparator and counts the comparisons. */
+	template <typename Compare>
+	class CountingComparator {
+		Compare const* _comp;
+
+	public:
+		constexpr CountingComparator(Compare const& comp) : _comp(&comp) {}
+
+		template <typename T, typename U>
+		constexpr bool operator()(T const& lhs, U const& rhs) const {
+			countOperations(&OperationCounts::comparisons, 1);
+			return (*_comp)(lhs, rhs);
+		}
+	};
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare, typename Container,
+          typename Layout = BinarySearchLayout>
 class FlatTree : private ValueComparator<Compare, Value, KeyOfValue>
 {
 	static constexpr bool _constIterator = STD::is_same<Key, Value>::value;
@@ -57,6 +77,7 @@ public:
 	using value_compare = ValueComparator<key_compare, value_type, KeyOfValue>;
 
 	using container_type = Container;
+	using layout_type = typename Layout::template rebind<key_type, container_type::max_size()>;
 
 	static_assert( STD::is_same<typename container_type::value_type, value_type>{} );
 
@@ -120,15 +141,30 @@ public:
 
 private:
 	container_type _container = {};
+	layout_type _layout = {};
+
+	/**< Must be called after every modification of _container. */
+	constexpr void _reindex() {
+		_layout.assign(_container.cbegin(), _container.cend(), KeyOfValue());
+	}
 
 	template <typename T>
 	constexpr iterator _inject( const_iterator it, T&& t ) {
-		return _container.insert(it, STD::forward<T>(t));
+		auto pos = _container.insert(it, STD::forward<T>(t));
+		_reindex();
+		return pos;
 	}
 
 protected:
 	constexpr value_compare const& _val_comp() const {return *this;}
+#ifdef CONSTAINER_COUNT_OPERATIONS
+	constexpr CountingComparator<key_compare> _key_comp() const {
+		key_compare const& comp = *this;
+		return comp;
+	}
+#else
 	constexpr   key_compare const& _key_comp() const {return *this;}
+#endif
 
 	using _const_iter_pair = STD::pair<const_iterator, const_iterator>;
 	using _iter_pair = STD::pair<iterator, iterator>;
@@ -148,19 +184,15 @@ public:
 	                    value_compare const& comp)
 		: value_compare(comp)
 	{
-		// More efficient assuming [first, last) is sorted to some extent
-		if(Unique)
-			while (first != last)
-				insert_unique(this->cend(), *first++);
-		else
-			while (first != last)
-				insert_equal (this->cend(), *first++);
+		_insert_range(STD::bool_constant<Unique>{}, first, last);
 	}
 
 	template <typename InputIt>
 	constexpr FlatTree( ordered_range_t, InputIt first, InputIt last,
 	                    value_compare const& comp)
-		: value_compare(comp), _container(first, last) {}
+		: value_compare(comp), _container(first, last) {
+		_reindex();
+	}
 
 	constexpr   key_compare   key_comp() const {return *this;}
 	constexpr value_compare value_comp() const {return *this;}
@@ -215,7 +247,7 @@ public:
 
 	constexpr       iterator find(key_type const& key) {
 		auto i = lower_bound(key), last = end();
-		return i == last || _key_comp()(key, i->key())? last : i;
+		return i == last || _key_comp()(key, KeyOfValue()(*i))? last : i;
 	}
 	constexpr const_iterator find(key_type const& key) const {
 		return const_cast<FlatTree*>(this)->find(key);
@@ -264,11 +296,19 @@ public:
 		return range.second - range.first;
 	}
 
+	constexpr bool contains(key_type const& key) const {
+		return find(key) != end();
+	}
+
 	constexpr iterator erase(const_iterator position) {
-		return _container.erase(position);
+		auto pos = _container.erase(position);
+		_reindex();
+		return pos;
 	}
 	constexpr iterator erase(const_iterator first, const_iterator last) {
-		return _container.erase(first, last);
+		auto pos = _container.erase(first, last);
+		_reindex();
+		return pos;
 	}
 	constexpr size_type erase(key_type const& key) {
 		auto range = equal_range(key);
@@ -279,15 +319,15 @@ public:
 		return ret;
 	}
 
-	constexpr void clear() {_container.clear();}
+	constexpr void clear() {_container.clear(); _reindex();}
 
 	constexpr iterator insert_equal(const_reference val) {
 		auto i = upper_bound(KeyOfValue()(val));
-		return _container.insert(i, val);
+		return _inject(i, val);
 	}
 	constexpr iterator insert_equal(value_type&& val) {
 		auto i = upper_bound(KeyOfValue()(val));
-		return _container.insert(i, STD::move(val));
+		return _inject(i, STD::move(val));
 	}
 
 	constexpr iterator insert_equal(const_iterator hint, const_reference val) {
@@ -325,60 +365,49 @@ public:
 		return unconstifyIterator(_container, ret.first);
 	}
 private:
-	template <typename InputIt>
-	constexpr void _insert_unique(ordered_unique_range_t, InputIt first, InputIt last, STD::input_iterator_tag) {
-		auto pos = end();
-		for (; first != last; ++first) {
-			pos = insert_unique(pos, *first).first;
-			++pos;
-		}
+	template <bool Unique, typename InputIt>
+	constexpr void _insert_sorted(STD::bool_constant<Unique> u, InputIt first, InputIt last, STD::input_iterator_tag) {
+		_insert_range(u, first, last);
 	}
-
-	template <typename BiDirIt>
-	constexpr void _insert_unique(ordered_unique_range_t, BiDirIt first, BiDirIt last, STD::bidirectional_iterator_tag) {
-		_insert_ordered_range(STD::true_type{}, first, last);
+	template <bool Unique, typename BiDirIt>
+	constexpr void _insert_sorted(STD::bool_constant<Unique> u, BiDirIt first, BiDirIt last, STD::bidirectional_iterator_tag) {
+		_merge_sorted(u, first, last);
 	}
 
 public:
 
+	/**< Inserts the range in O((n + m) log m) time. If several elements of [first, last) have equivalent keys,
+	     it is unspecified which of them is inserted. */
 	template <typename InputIt>
 	constexpr void insert_unique(InputIt first, InputIt last) {
-		while (first != last)
-			insert_unique(*first++);
+		_insert_range(STD::true_type{}, first, last);
 	}
 
 	template <typename InputIt>
 	constexpr void insert_unique(ordered_unique_range_t, InputIt first, InputIt last) {
-		_insert_unique(ordered_unique_range, first, last, iteratorCategory<InputIt>{});
+		_insert_sorted(STD::true_type{}, first, last, iteratorCategory<InputIt>{});
 	}
 
+	/**< Inserts the range in O((n + m) log m) time. Elements of [first, last) are inserted after existing elements
+	     with equivalent keys, but their relative order is unspecified. */
 	template <typename InputIt>
 	constexpr void insert_equal(InputIt first, InputIt last) {
-		while (first != last)
-			insert_equal(*first++);
+		_insert_range(STD::false_type{}, first, last);
 	}
 
-private:
 	template <typename InputIt>
-	constexpr void _insert_equal(ordered_range_t, InputIt first, InputIt last, STD::input_iterator_tag) {
-		auto pos = end();
-		while (first != last) {
-			// Potential performance boost if several elements can be inserted adjacently
-			pos = insert_equal(pos, *first++);
-			++pos;
-		}
+	constexpr void insert_equal(ordered_range_t, InputIt first, InputIt last) {
+		_insert_sorted(STD::false_type{}, first, last, iteratorCategory<InputIt>{});
 	}
 
-	template <typename BiDirIt>
-	constexpr void _insert_equal(ordered_range_t, BiDirIt first, BiDirIt last, STD::bidirectional_iterator_tag) {
-		insert_ordered_range(false, first, last);
+	/**< Inserts the elements of source in linear time. */
+	template <typename OtherContainer, typename OtherLayout>
+	constexpr void merge_unique(FlatTree<Key, Value, KeyOfValue, Compare, OtherContainer, OtherLayout> const& source) {
+		_merge_sorted(STD::true_type{}, source.begin(), source.end());
 	}
-
-public:
-
-	template <typename InputIt>
-	constexpr void insert_equal(ordered_range_t, InputIt first, InputIt last) {
-		_insert_equal(ordered_range, first, last, iteratorCategory<InputIt>{});
+	template <typename OtherContainer, typename OtherLayout>
+	constexpr void merge_equal(FlatTree<Key, Value, KeyOfValue, Compare, OtherContainer, OtherLayout> const& source) {
+		_merge_sorted(STD::false_type{}, source.begin(), source.end());
 	}
 
 	template <typename... Args>
@@ -409,37 +438,23 @@ public:
 
 protected:
 
+	/**< Searches on the entire sequence are delegated to the layout; those on subranges, which only occur
+	     during insertion, use binary search. */
+	constexpr bool _is_whole(const_iterator first, const_iterator last) const {
+		return first == cbegin() && last == cend();
+	}
+
 	template <typename T>
 	constexpr const_iterator _lower_bound(const_iterator first, const_iterator last, T const& key) const {
-		auto& cmp = _key_comp();
-		size_type count = last-first;
-		while (count > 0) {
-			auto intervall_size = count / 2;
-			auto it = first + intervall_size;
-			if (cmp(KeyOfValue()(*it), key)) {
-				first = ++it;
-				count -= intervall_size + 1;
-			}
-			else
-				count = intervall_size;
-		}
-		return first;
+		if (_is_whole(first, last))
+			return _layout.lower_bound(first, last, key, KeyOfValue(), _key_comp());
+		return BinarySearchLayout::lower_bound(first, last, key, KeyOfValue(), _key_comp());
 	}
 	template <typename T>
 	constexpr const_iterator _upper_bound(const_iterator first, const_iterator last, T const& key) const {
-		auto& cmp = _key_comp();
-		size_type count = last-first;
-		while (count > 0) {
-			auto intervall_size = count / 2;
-			auto it = first + intervall_size;
-			if (not cmp(key, KeyOfValue()(*it))) {
-				first = ++it;
-				count -= intervall_size + 1;
-			}
-			else
-				count = intervall_size;
-		}
-		return first;
+		if (_is_whole(first, last))
+			return _layout.upper_bound(first, last, key, KeyOfValue(), _key_comp());
+		return BinarySearchLayout::upper_bound(first, last, key, KeyOfValue(), _key_comp());
 	}
 	template <typename T>
 	constexpr iterator _lower_bound(const_iterator first, const_iterator last, T const& key) {
@@ -516,29 +531,11 @@ protected:
 		else return _lower_bound(pos, cend(), KeyOfValue()(val));
 	}
 
-	/**< Derived from boost::container::flat_tree<>::priv_equal_range. */
 	template <typename T>
 	constexpr _const_iter_pair _equal_range(const_iterator first, const_iterator last, T const& key) const {
-		auto const& key_comp = _key_comp();
-		KeyOfValue key_extract;
-		size_type len = last - first;
-
-		while (len != 0) {
-			auto step = len / 2;
-			auto middle = first + step;
-
-			if (key_comp(key_extract(*middle), key)){
-				first = ++middle;
-				len -= step + 1;
-			}
-			else if (key_comp(key, key_extract(*middle)))
-				len = step;
-			else
-				// Here, key == *middle. Perform bound searches in both directions.
-				return {_lower_bound(first   , middle   , key),
-				        _upper_bound(middle+1, first+len, key)};
-		}
-		return {first, first};
+		if (_is_whole(first, last))
+			return _layout.equal_range(first, last, key, KeyOfValue(), _key_comp());
+		return BinarySearchLayout::equal_range(first, last, key, KeyOfValue(), _key_comp());
 	}
 	template <typename T>
 	constexpr _iter_pair _equal_range(const_iterator first, const_iterator last, T const& key) {
@@ -557,60 +554,163 @@ protected:
 		return {pos, pos};
 	}
 
-	/**< The following algorithm was taken from boost::container::flat_tree<>::priv_insert_ordered_range. */
+	/**< Merges the sorted range [first, last) into the tree. If Unique, elements whose key is already present
+	     (in the tree, or earlier in the range) are skipped. */
 	template <bool Unique, typename BiDirIt>
-	constexpr void _insert_ordered_range(STD::bool_constant<Unique>, BiDirIt first, BiDirIt last)
+	constexpr void _merge_sorted(STD::bool_constant<Unique> u, BiDirIt first, BiDirIt last) {
+		// Containers with non-pointer iterators (e.g. StableVector) promise that elements never move between
+		// nodes, so their elements must be inserted individually.
+		_merge_sorted(u, first, last, STD::is_pointer<iterator>{});
+	}
+
+	/**< Inserts the elements one after another, resuming each search at the previous insertion point. */
+	template <bool Unique, typename BiDirIt>
+	constexpr void _merge_sorted(STD::bool_constant<Unique>, BiDirIt first, BiDirIt last, STD::false_type)
 	{
-		size_type len = Constainer::distance(first, last), BurstSize=len;
-		//Auxiliary data for insertion positions.
-		Constainer::Vector<size_type, max_size()> positions(len);
-		auto b = begin(), pos = b, ce = end();
 		auto const& val_cmp = _val_comp();
-		//Loop in burst sizes
-		bool back_insert = false;
-		while (len != 0 && not back_insert) {
-			auto burst = STD::min(len, BurstSize);
-			size_type unique_burst = 0, checked = 0;
-			for(; checked != burst; ++checked) {
-				//Get the insertion position for each key
-				auto const& val = *first;
-				pos = _lower_bound(pos, ce, KeyOfValue()(val));
-				//Check if already present
-				if (pos != ce) {
-					++first;
-					--len;
-					if (Unique && !val_cmp(val, *pos))
-						positions[checked] = size_type(-1);
-					else {
-						++unique_burst;
-						positions[checked] = pos - b;
-					}
-				}
-				else { //this element and the remaining should be back inserted
-					back_insert = true;
-					break;
-				}
+		auto pos = cbegin();
+		for (auto it = first, prev = first; it != last; prev = it++) {
+			if (Unique) {
+				if (it != first && !val_cmp(*prev, *it))
+					continue;
+				pos = BinarySearchLayout::lower_bound(pos, cend(), KeyOfValue()(*it), KeyOfValue(), _key_comp());
+				if (pos != cend() && !val_cmp(*it, *pos))
+					continue;
 			}
-			if (unique_burst != 0) {
-				AssertExcept<STD::bad_alloc>(max_size() - size() >= unique_burst);
-				insert_ordered_at(_container, unique_burst, first, positions.begin() + checked);
-				pos += unique_burst;
+			else
+				pos = BinarySearchLayout::upper_bound(pos, cend(), KeyOfValue()(*it), KeyOfValue(), _key_comp());
+			pos = Constainer::next(_container.insert(pos, *it));
+		}
+		_reindex();
+	}
+
+	/**< Merges in linear time: The container is resized to accommodate the new elements, which are then
+	     moved into place from the back. */
+	template <bool Unique, typename BiDirIt>
+	constexpr void _merge_sorted(STD::bool_constant<Unique>, BiDirIt first, BiDirIt last, STD::true_type)
+	{
+		auto const& val_cmp = _val_comp();
+		size_type added = 0;
+		{
+			auto pos = cbegin(), ce = cend();
+			for (auto it = first, prev = first; it != last; prev = it++) {
+				if (Unique) {
+					if (it != first && !val_cmp(*prev, *it))
+						continue;
+					while (pos != ce && val_cmp(*pos, *it))
+						++pos;
+					if (pos != ce && !val_cmp(*it, *pos))
+						continue;
+				}
+				++added;
 			}
 		}
-		//The remaining range should be back inserted
-		if (len != 0) {
-			if(Unique)
-				do {
-					auto next = Constainer::next(first);
-					auto const& val = *first;
-					if (next == last || val_cmp(val, *next))
-						_container.push_back(val);
-
-					first = next;
-				} while (--len != 0);
+		AssertExcept<STD::bad_alloc>(max_size() - size() >= added);
+
+		auto n = size();
+		_container.resize(n + added);
+		auto b = begin(), pos = b + n, out = end();
+		while (added != 0) {
+			auto const& val = *--last;
+			if (Unique && last != first && !val_cmp(*Constainer::prev(last), val))
+				continue;
+			for (; pos != b && val_cmp(val, pos[-1]); --pos)
+				*--out = STD::move(pos[-1]);
+			if (Unique && pos != b && !val_cmp(pos[-1], val))
+				continue;
+			*--out = val;
+			--added;
+		}
+		_reindex();
+	}
+
+	template <bool Unique, typename InputIt>
+	constexpr void _insert_range(STD::bool_constant<Unique> u, InputIt first, InputIt last) {
+		_insert_range(u, first, last, STD::is_pointer<iterator>{});
+	}
+
+	/**< Inserts the elements one after another, as elements must not move between nodes (see _merge_sorted). */
+	template <bool Unique, typename InputIt>
+	constexpr void _insert_range(STD::bool_constant<Unique>, InputIt first, InputIt last, STD::false_type)
+	{
+		auto const& val_cmp = _val_comp();
+		for (; first != last; ++first) {
+			value_type val(*first);
+			auto const& key = KeyOfValue()(val);
+			const_iterator pos;
+			if (Unique) {
+				pos = BinarySearchLayout::lower_bound(cbegin(), cend(), key, KeyOfValue(), _key_comp());
+				if (pos != cend() && !val_cmp(val, *pos))
+					continue;
+			}
 			else
-				_container.insert(end(), len, first);
+				pos = BinarySearchLayout::upper_bound(cbegin(), cend(), key, KeyOfValue(), _key_comp());
+			_container.insert(pos, STD::move(val));
+		}
+		_reindex();
+	}
+
+	/**< Sorts the elements behind the first n ones. Unique trees then erase every one of them that is equivalent
+	     to a preceding one or to one of the first n elements. */
+	template <bool Unique>
+	constexpr void _sort_tail(STD::bool_constant<Unique>, size_type n) {
+		auto const& val_cmp = _val_comp();
+		auto b = _container.begin(), mid = b + n;
+		Constainer::sort(mid, _container.end(), val_cmp);
+		if (!Unique)
+			return;
+
+		auto pos = b, out = mid;
+		for (auto it = mid; it != _container.end(); ++it) {
+			if (out != mid && !val_cmp(out[-1], *it))
+				continue;
+			pos = BinarySearchLayout::lower_bound(pos, mid, KeyOfValue()(*it), KeyOfValue(), _key_comp());
+			if (pos != mid && !val_cmp(*it, *pos))
+				continue;
+			if (out != it)
+				*out = STD::move(*it);
+			++out;
+		}
+		_container.erase(out, _container.end());
+	}
+
+	/**< Whether [_container.begin()+first, _container.begin()+last), which must be sorted, holds an element
+	     equivalent to val. */
+	constexpr bool _holds(size_type first, size_type last, const_reference val) const {
+		auto b = _container.cbegin();
+		auto pos = BinarySearchLayout::lower_bound(b + first, b + last, KeyOfValue()(val), KeyOfValue(), _key_comp());
+		return pos != b + last && !_val_comp()(val, *pos);
+	}
+
+	/**< Appends [first, last) to the container, sorts the appended elements and merges them into place, without a
+	     buffer. Once a unique tree is full, the appended elements are deduplicated to make room for the rest, and
+	     elements already present are skipped. Otherwise, the appended elements are erased and bad_alloc is thrown. */
+	template <bool Unique, typename InputIt>
+	constexpr void _insert_range(STD::bool_constant<Unique> u, InputIt first, InputIt last, STD::true_type)
+	{
+		auto n = size();
+		// Whether the appended elements are sorted and deduplicated
+		bool settled = true;
+		for (; first != last; ++first) {
+			value_type val(*first);
+			if (Unique && size() == max_size()) {
+				if (!settled) {
+					_sort_tail(u, n);
+					settled = true;
+				}
+				if (size() == max_size() && (_holds(0, n, val) || _holds(n, size(), val)))
+					continue;
+			}
+			if (size() == max_size()) {
+				_container.erase(_container.begin() + n, _container.end());
+				AssertExcept<STD::bad_alloc>( false );
+			}
+			_container.push_back(STD::move(val));
+			settled = false;
 		}
+		_sort_tail(u, n);
+		Constainer::inplace_merge(_container.begin(), _container.begin() + n, _container.end(), _val_comp());
+		_reindex();
 	}
 };
 
@@ -9,10 +9,11 @@
 
 namespace Constainer { namespace detail {
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare, typename Container>
+template <typename Key, typename Value, typename KeyOfValue, typename Compare, typename Container,
+          typename Layout = BinarySearchLayout>
 class FlatUniqueTree
-	: public      FlatTree<Key, Value, KeyOfValue, Compare, Container> {
-	using _base = FlatTree<Key, Value, KeyOfValue, Compare, Container>;
+	: public      FlatTree<Key, Value, KeyOfValue, Compare, Container, Layout> {
+	using _base = FlatTree<Key, Value, KeyOfValue, Compare, Container, Layout>;
 
 	using typename _base::_iter_pair;
 	using typename _base::_const_iter_pair;
@@ -24,6 +25,8 @@ class FlatUniqueTree
 	using _base::emplace_hint_equal;
 	using _base::emplace_unique;
 	using _base::emplace_hint_unique;
+	using _base::merge_unique;
+	using _base::merge_equal;
 	using _base::equal_range;
 
 public:
@@ -102,6 +105,11 @@ public:
 		insert(ordered_unique_range, ilist.begin(), ilist.end());
 	}
 
+	template <typename Source>
+	constexpr void merge(Source const& source) {
+		_base::merge_unique(source);
+	}
+
 	template <typename... Args>
 	constexpr STD::pair<iterator, bool> emplace(Args&&... args) {
 		return this->emplace_unique(STD::forward<Args>(args)...);
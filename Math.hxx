@@ -132,6 +132,18 @@ CONSTAINER_PURE_CONST constexpr unsigned count_trailing( STD::uint64_t v ) {
 	#endif
 }
 
+CONSTAINER_PURE_CONST constexpr unsigned count_leading( STD::uint64_t v ) {
+	#if defined __clang__ || defined __GNUG__
+		return __builtin_clzll(v);
+	#else
+		unsigned n = 0;
+		for (unsigned shift = 32; shift != 0; shift /= 2)
+			if ((v >> (64 - shift - n)) == 0)
+				n += shift;
+		return n;
+	#endif
+}
+
 /**< Obtains the fractional part of r by subtracting powers of two. */
 template <typename Real>
 CONSTAINER_PURE_CONST constexpr Real fractional (Real r)
@@ -178,10 +190,26 @@ CONSTAINER_PURE_CONST constexpr STD::uintmax_t rounded_remainder (Real r, STD::u
 	return remainder (r, u) + 0.5;
 }
 
-// Doesn't correctly determine negative zeroes yet.
+namespace detail {
+	template <typename T>
+	CONSTAINER_PURE_CONST constexpr bool hasSignBit ( T t, STD::false_type ) {
+		return t < 0;
+	}
+	template <typename T>
+	CONSTAINER_PURE_CONST constexpr bool hasSignBit ( T t, STD::true_type ) {
+	#if defined __clang__ || defined __GNUG__
+		return __builtin_signbit(t);
+	#else
+		// Doesn't correctly determine negative zeroes.
+		return t < 0;
+	#endif
+	}
+}
+
+/**< Whether the sign of t is negative, including negative zero. */
 template <typename T>
 CONSTAINER_PURE_CONST constexpr bool is_negative ( T t ) {
-	return t < 0 /*|| 1/t == -STD::numeric_limits<T>::infinity()*/;
+	return detail::hasSignBit(t, STD::is_floating_point<T>{});
 }
 
 /**< Inefficient implementation; However, constexpr forbids e.g. aliasing through char,
@@ -241,19 +269,4 @@ CONSTAINER_PURE_CONST constexpr STD::pair<Real, int> normalize (int base, Real r
 	return {negative? -r : r, exp_sum};
 }
 
-template <typename T>
-constexpr T ln10 = 2.3025850929940456840179914546843L;
-template <typename Real>
-CONSTAINER_PURE_CONST constexpr Real pow10(Real x) {
-	Real sum=1, fact=1;
-	auto y = x * ln10<Real>;
-	x = y;
-	for (int i=2; i < STD::numeric_limits<Real>::max_digits10+5; ++i) {
-		sum += fact*x;
-		x *= y;
-		fact /= i;
-	}
-	return sum;
-}
-
 }
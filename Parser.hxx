@@ -6,6 +6,7 @@
 
 #include "String.hxx"
 #include "Math.hxx"
+#include "impl/FloatConversion.hxx"
 
 namespace Constainer {
 
@@ -20,8 +21,16 @@ namespace detail {
 
 	template <typename InputIt>
 	constexpr InputIt skipWS(InputIt first, InputIt last) {
-		String whitespace = " \t\n\f\v\r";
-		return Constainer::find_first_not_of(first, last, whitespace.begin(), whitespace.end());
+		char const whitespace[] = " \t\n\f\v\r";
+		return Constainer::find_first_not_of(first, last, whitespace, whitespace + sizeof whitespace - 1);
+	}
+
+	/**< The value of c as a digit in the given base, or -1. */
+	CONSTAINER_PURE_CONST constexpr int digitValue(int c, int base) {
+		c = toupper(c);
+		int value = c >= '0' && c <= '9'? c - '0'
+		          : c >= 'A' && c <= 'Z'? c - 'A' + 10 : base;
+		return value < base? value : -1;
 	}
 
 	template <typename Arithmetic, typename InputIt>
@@ -70,8 +79,6 @@ constexpr auto strToInt( InputIt first, InputIt last, Int& res, int base=10 )
 	constexpr auto MAX = STD::numeric_limits<Int>::max(),
 	               MIN = STD::numeric_limits<Int>::lowest();
 
-	String digits = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-
 	res = 0; // So premature error returns set res to zero
 
 	first = detail::skipWS(first, last);
@@ -100,9 +107,9 @@ constexpr auto strToInt( InputIt first, InputIt last, Int& res, int base=10 )
 
 	res = 0;
 	bool read = false;
-	STD::size_t found=0;
+	int found = 0;
 	while (first != last
-	   && (found = digits.rfind(toupper(*first), base-1)) != digits.npos)
+	   && (found = detail::digitValue(*first, base)) != -1)
 	{
 		const auto summand = sign*Int(found);
 
@@ -158,12 +165,12 @@ constexpr auto strToInt( BasicString<char, N> const& str, STD::size_t str_pos =
 	return strToInt<Int>(str.data()+str_pos, str.size(), pos, base);
 }
 
+/**< Decimal input is rounded correctly. The digits are read a second time in the rare cases that need all of them,
+     so InputIt must be a forward iterator. */
 template <typename Float, typename InputIt>
 constexpr auto strToFloat( InputIt first, InputIt last, Float& res )
 	-> require<STD::is_floating_point<Float>, ParserState<InputIt>>
 {
-	String digits = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-
 	res = 0; // So a premature return (see below) does not leave res unset
 
 	first = detail::skipWS(first, last);
@@ -233,7 +240,8 @@ constexpr auto strToFloat( InputIt first, InputIt last, Float& res )
 
 		if (first != last && *first == '(') {
 			//! TODO: Implement proper NaN-String recognition
-			first = Constainer::find_first_not_of(first+1, last, digits.begin(), digits.end());
+			char const alnum[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz_";
+			first = Constainer::find_first_not_of(first+1, last, alnum, alnum + sizeof alnum - 1);
 			if (first == last || *first !=  ')')
 				return {first, PState::Eof};
 		}
@@ -243,11 +251,32 @@ constexpr auto strToFloat( InputIt first, InputIt last, Float& res )
 	}
 	}
 
+	if (base == 10) {
+		auto digits_first = first;
+		detail::DigitScan<STD::uint64_t> scan;
+		first = detail::scanDigits(first, last, scan, 19);
+		if (!read && !scan.read) {res = 0; return {first, PState::Eof};}
+		auto digits_last = first;
+
+		int exp = 0;
+		if (first != last && toupper(*first) == 'E') {
+			++first;
+			auto p_state = strToInt(first, last, exp, 10);
+			first = p_state.iterator;
+			if (p_state.state != PState::Good) {
+				res = 0;
+				return {first, p_state.state};
+			}
+		}
+		res = sign * detail::decimalToFloat<Float>(digits_first, digits_last, scan, exp);
+		return {first, PState::Good};
+	}
+
 	Float multiplier = 1;
 	for (; first != last; ++first)
 	{
-		STD::size_t found = digits.rfind(toupper(*first), base-1);
-		if (found == digits.npos) {
+		int found = detail::digitValue(*first, base);
+		if (found == -1) {
 			if (*first != '.' || multiplier != 1)
 				break;
 			multiplier /= base;
@@ -272,9 +301,8 @@ constexpr auto strToFloat( InputIt first, InputIt last, Float& res )
 
 	if (!read) {res = 0; return {first, PState::Eof};}
 
-	// Apply exponent
-	const char exp_char = base==10? 'E' : 'P';
-	if (first != last && toupper(*first) == exp_char) {
+	// Apply binary exponent
+	if (first != last && toupper(*first) == 'P') {
 		++first;
 		int exp=0;
 		auto p_state = strToInt(first, last, exp, 10); // exponent is always decimal
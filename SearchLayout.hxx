@@ -0,0 +1,170 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+#include "Array.hxx"
+#include "Math.hxx"
+
+#include <cstdint>
+
+namespace Constainer {
+
+/**< Search layouts determine how FlatTree searches its sorted sequence. A layout is rebound to the key type and
+     capacity of the tree, and its assign member is called with the sorted sequence after each modification. */
+
+/**< Plain binary search on the sorted sequence itself. Needs no additional memory. */
+struct BinarySearchLayout {
+	template <typename Key, STD::size_t MaxN>
+	using rebind = BinarySearchLayout;
+
+	template <typename RandomIt, typename KeyOfValue>
+	constexpr void assign(RandomIt, RandomIt, KeyOfValue) {}
+
+	template <typename RandomIt, typename T, typename KeyOfValue, typename Compare>
+	static constexpr RandomIt lower_bound(RandomIt first, RandomIt last, T const& key,
+	                                      KeyOfValue key_extract, Compare const& cmp) {
+		auto count = last-first;
+		while (count > 0) {
+			auto intervall_size = count / 2;
+			auto it = first + intervall_size;
+			if (cmp(key_extract(*it), key)) {
+				first = ++it;
+				count -= intervall_size + 1;
+			}
+			else
+				count = intervall_size;
+		}
+		return first;
+	}
+	template <typename RandomIt, typename T, typename KeyOfValue, typename Compare>
+	static constexpr RandomIt upper_bound(RandomIt first, RandomIt last, T const& key,
+	                                      KeyOfValue key_extract, Compare const& cmp) {
+		auto count = last-first;
+		while (count > 0) {
+			auto intervall_size = count / 2;
+			auto it = first + intervall_size;
+			if (not cmp(key, key_extract(*it))) {
+				first = ++it;
+				count -= intervall_size + 1;
+			}
+			else
+				count = intervall_size;
+		}
+		return first;
+	}
+
+	/**< Derived from boost::container::flat_tree<>::priv_equal_range. */
+	template <typename RandomIt, typename T, typename KeyOfValue, typename Compare>
+	static constexpr STD::pair<RandomIt, RandomIt> equal_range(RandomIt first, RandomIt last, T const& key,
+	                                                           KeyOfValue key_extract, Compare const& cmp) {
+		auto len = last - first;
+
+		while (len != 0) {
+			auto step = len / 2;
+			auto middle = first + step;
+
+			if (cmp(key_extract(*middle), key)){
+				first = ++middle;
+				len -= step + 1;
+			}
+			else if (cmp(key, key_extract(*middle)))
+				len = step;
+			else
+				// Here, key == *middle. Perform bound searches in both directions.
+				return {lower_bound(first   , middle   , key, key_extract, cmp),
+				        upper_bound(middle+1, first+len, key, key_extract, cmp)};
+		}
+		return {first, first};
+	}
+};
+
+namespace detail {
+	/**< Holds a copy of the keys in BFS order of the implicit search tree (1-based, children of k are 2k and 2k+1),
+	     along with the position of each key in the sorted sequence. Consecutive levels of the tree are adjacent in memory,
+	     so the top of the tree stays in cache, and the grandchildren four levels down share a cache line and can be
+	     prefetched while the comparisons of the intermediate levels are being done. The descent is branchless. */
+	template <typename Key, STD::size_t MaxN>
+	class EytzingerIndex {
+		using size_type = STD::size_t;
+		using _index_type = STD::conditional_t<(MaxN <= 0xFF),   STD::uint8_t,
+		                    STD::conditional_t<(MaxN <= 0xFFFF), STD::uint16_t, STD::uint32_t>>;
+
+		// Number of levels the prefetch is ahead of the descent. The 2^4 descendants of a node four levels down are
+		// adjacent and start at index 16*k.
+		static constexpr size_type _prefetch_levels = 4;
+
+		Array<Key, MaxN+1> _keys{};
+		Array<_index_type, MaxN+1> _ranks{};
+		size_type _size = 0;
+
+		template <typename RandomIt, typename KeyOfValue>
+		constexpr void _fill(size_type k, RandomIt first, size_type& rank, KeyOfValue key_extract) {
+			if (k > _size)
+				return;
+			_fill(2*k, first, rank, key_extract);
+			_keys[k] = key_extract(first[rank]);
+			_ranks[k] = rank++;
+			_fill(2*k+1, first, rank, key_extract);
+		}
+
+		/**< Returns the rank of the first key for which pred is false, given that pred partitions the keys. */
+		template <typename Pred>
+		constexpr size_type _partition_point(Pred pred) const {
+			size_type k = 1;
+			while (k <= _size) {
+				prefetch(_keys.data() + STD::min(k << _prefetch_levels, _size));
+				k = 2*k + pred(_keys[k]);
+			}
+			// The path ends with a sequence of right turns (after the last left turn); undo them, plus the left turn.
+			k >>= count_trailing(~k) + 1;
+			return k == 0? _size : _ranks[k];
+		}
+
+		template <typename T, typename Compare>
+		struct _Less {
+			T const& key; Compare const& cmp;
+			constexpr bool operator()(Key const& k) const {return cmp(k, key);}
+		};
+		template <typename T, typename Compare>
+		struct _NotGreater {
+			T const& key; Compare const& cmp;
+			constexpr bool operator()(Key const& k) const {return !cmp(key, k);}
+		};
+
+	public:
+		template <typename RandomIt, typename KeyOfValue>
+		constexpr void assign(RandomIt first, RandomIt last, KeyOfValue key_extract) {
+			_size = last - first;
+			assert(_size <= MaxN);
+			size_type rank = 0;
+			_fill(1, first, rank, key_extract);
+		}
+
+		template <typename RandomIt, typename T, typename KeyOfValue, typename Compare>
+		constexpr RandomIt lower_bound(RandomIt first, RandomIt last, T const& key, KeyOfValue, Compare const& cmp) const {
+			assert(size_type(last-first) == _size && "Stale index");
+			return first + _partition_point(_Less<T, Compare>{key, cmp});
+		}
+		template <typename RandomIt, typename T, typename KeyOfValue, typename Compare>
+		constexpr RandomIt upper_bound(RandomIt first, RandomIt last, T const& key, KeyOfValue, Compare const& cmp) const {
+			assert(size_type(last-first) == _size && "Stale index");
+			return first + _partition_point(_NotGreater<T, Compare>{key, cmp});
+		}
+		template <typename RandomIt, typename T, typename KeyOfValue, typename Compare>
+		constexpr STD::pair<RandomIt, RandomIt> equal_range(RandomIt first, RandomIt last, T const& key,
+		                                                    KeyOfValue key_extract, Compare const& cmp) const {
+			return {lower_bound(first, last, key, key_extract, cmp), upper_bound(first, last, key, key_extract, cmp)};
+		}
+	};
+}
+
+/**< Searches a separate copy of the keys that is laid out in Eytzinger (BFS) order. This trades memory and
+     O(n) work per modification for cache-friendly lookups on large, rarely modified trees. */
+struct EytzingerLayout {
+	template <typename Key, STD::size_t MaxN>
+	using rebind = detail::EytzingerIndex<Key, MaxN>;
+};
+
+}
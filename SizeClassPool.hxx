@@ -0,0 +1,163 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+#include "ChunkPool.hxx"
+
+namespace Constainer {
+
+namespace detail {
+	/**< Storage for N/BlockSize blocks of BlockSize contiguous objects each. */
+	template <typename T, STD::size_t N, STD::size_t BlockSize>
+	class BlockClass {
+		static_assert( BlockSize != 0 && BlockSize <= N, "Invalid block size" );
+
+	public:
+		using size_type = STD::size_t;
+
+		static constexpr size_type block_size = BlockSize;
+		static constexpr size_type blocks = N/BlockSize;
+
+	private:
+		Array<T, blocks*BlockSize> _storage{};
+		SlotAllocator<blocks> _slots;
+
+	public:
+		constexpr size_type used() const {return _slots.used();}
+		constexpr size_type available() const {return _slots.available();}
+
+		constexpr T* allocate() {
+			auto first = _storage.data() + _slots.grab()*BlockSize;
+			Constainer::fill_n(first, BlockSize, T());
+			return first;
+		}
+		constexpr void deallocate(T const* p) {
+			auto offset = p - _storage.data();
+			assert( offset % BlockSize == 0 && "Not the beginning of a block" );
+			_slots.free(offset / BlockSize);
+		}
+		constexpr void free() {_slots.free();}
+	};
+
+	template <typename T, STD::size_t N, STD::size_t... BlockSizes>
+	class SizeClasses {
+	public:
+		using size_type = STD::size_t;
+
+		constexpr size_type used() const {return 0;}
+		constexpr size_type available(size_type) const {return 0;}
+		constexpr T* allocate(size_type) {
+			AssertExcept<STD::bad_alloc>( false );
+			return nullptr;
+		}
+		constexpr void deallocate(T const*, size_type) {
+			assert( !"No size class fits" );
+		}
+		constexpr void free() {}
+	};
+
+	template <typename T, STD::size_t N, STD::size_t BlockSize, STD::size_t... BlockSizes>
+	class SizeClasses<T, N, BlockSize, BlockSizes...> {
+		BlockClass<T, N, BlockSize> _first;
+		SizeClasses<T, N, BlockSizes...> _rest;
+
+	public:
+		using size_type = STD::size_t;
+
+		constexpr size_type used() const {return _first.used() + _rest.used();}
+		constexpr size_type available(size_type n) const {
+			return n <= BlockSize? _first.available() : _rest.available(n);
+		}
+
+		constexpr T* allocate(size_type n) {
+			return n <= BlockSize? _first.allocate() : _rest.allocate(n);
+		}
+		constexpr void deallocate(T const* p, size_type n) {
+			if (n <= BlockSize)
+				_first.deallocate(p);
+			else
+				_rest.deallocate(p, n);
+		}
+		constexpr void free() {_first.free(); _rest.free();}
+	};
+
+	template <STD::size_t... BlockSizes>
+	struct areAscending : STD::true_type {};
+	template <STD::size_t S1, STD::size_t S2, STD::size_t... BlockSizes>
+	struct areAscending<S1, S2, BlockSizes...>
+		: STD::integral_constant<bool, (S1 < S2) && areAscending<S2, BlockSizes...>{}> {};
+}
+
+/**< A pool front end that serves contiguous runs of objects from segregated size classes, each of which
+     has N objects of storage split into blocks of one of the (strictly ascending) BlockSizes. A run of n objects
+     is taken from the smallest class whose blocks hold n objects, in O(1); the same n must be passed back to
+     deallocate. Single objects are served by the first class, which makes SizeClassPool usable as the Pool
+     parameter of BasicStableVector, e.g. BasicStableVector<T, SizeClassPool<T, 256, 1, 8, 64>>. */
+template <typename T, STD::size_t N, STD::size_t... BlockSizes>
+class SizeClassPool {
+	static_assert( sizeof...(BlockSizes) != 0, "SizeClassPool needs at least one size class" );
+	static_assert( detail::areAscending<BlockSizes...>{}, "Block sizes must be strictly ascending" );
+
+	static constexpr STD::size_t _block_sizes[] {BlockSizes...};
+
+	detail::SizeClasses<T, N, BlockSizes...> _classes;
+
+public:
+
+	template <typename U>
+	using rebind = SizeClassPool<U, N, BlockSizes...>;
+
+	using size_type       = STD::size_t;
+	using value_type      = T;
+	using pointer         = T*;
+	using const_pointer   = T const*;
+	using reference       = T&;
+	using const_reference = T const&;
+
+	/**< The number of single objects that can be grabbed. */
+	static constexpr size_type max_size() {return N/_block_sizes[0];}
+	/**< The largest run that can be allocated at once. */
+	static constexpr size_type max_block_size() {return _block_sizes[sizeof...(BlockSizes)-1];}
+
+	/**< The number of blocks in use, across all classes. Blocks of different classes hold different numbers of
+	     objects, so unlike ChunkPool::used(), this does not compare to max_size(). */
+	constexpr size_type used_blocks() const {return _classes.used();}
+	/**< The number of runs of n objects that can still be allocated. */
+	constexpr size_type available(size_type n = 1) const {return _classes.available(n);}
+
+	/**< Obtains n value-initialized, contiguous objects. */
+	constexpr pointer allocate(size_type n) {
+		assert( n != 0 );
+		return _classes.allocate(n);
+	}
+	constexpr void deallocate(const_pointer p, size_type n) {
+		_classes.deallocate(p, n);
+	}
+
+	constexpr pointer grab() {return allocate(1);}
+	/**< Grabs n single objects at once and writes pointers to them to out. Either all objects are grabbed or none. */
+	template <typename OutputIt>
+	constexpr OutputIt grab_n(size_type n, OutputIt out) {
+		AssertExcept<STD::bad_alloc>( n <= available() );
+		while (n--)
+			*out++ = grab();
+		return out;
+	}
+
+	constexpr void free() {_classes.free();}
+	constexpr void free(const_pointer p) {deallocate(p, 1);}
+	/**< Frees the n single objects pointed to by [first, first+n). */
+	template <typename InputIt>
+	constexpr InputIt free_n(InputIt first, size_type n) {
+		while (n--)
+			free(*first++);
+		return first;
+	}
+};
+
+template <typename T, STD::size_t N, STD::size_t... BlockSizes>
+constexpr STD::size_t SizeClassPool<T, N, BlockSizes...>::_block_sizes[];
+
+}
@@ -7,11 +7,14 @@
 #include "impl/Fundamental.hxx"
 #include "Vector.hxx"
 #include "ChunkPool.hxx"
+#include "StableVectorIndex.hxx"
 #include "Operators.hxx"
 
 namespace Constainer {
 
-template <typename T, typename Pool>
+/**< Elements are allocated individually from Pool and never move; the Index policy (see StableVectorIndex.hxx)
+     keeps the node pointers in order. */
+template <typename T, typename Pool, typename Index = FlatIndex>
 class BasicStableVector
 {
 	struct Node;
@@ -19,6 +22,7 @@ class BasicStableVector
 public:
 
 	using pool_type = typename Pool::template rebind<Node>;
+	using index_type = typename Index::template rebind<Node, pool_type::max_size()+1>;
 
 	using value_type      = T;
 	using size_type       = STD::size_t;
@@ -33,8 +37,6 @@ public:
 private:
 	template <bool _const>
 	class _iterator_base;
-	using _pointer_container = Vector<Node*, max_size()+1>;
-	using _pointer_iter = Node**;
 
 public:
 
@@ -47,11 +49,9 @@ public:
 private:
 	struct Node {
 		T value = {};
-		using _pointer_iter = Node**;
-		_pointer_iter up = nullptr;
+		// The slot of the index that points to this node.
+		Node** up = nullptr;
 
-		constexpr Node(const_reference value, _pointer_iter up)
-			: value(value), up(up) {}
 		constexpr Node() = default;
 
 		constexpr Node& operator=(Node const&) = default;
@@ -59,19 +59,17 @@ private:
 		constexpr Node(Node const&) = default;
 		constexpr Node(Node &&) = default;
 
-		constexpr void setParent(_pointer_iter it) {
-			up = it;
-			*up = this;
-		}
+		// The pool hands out value-initialized nodes.
+		constexpr void construct() {}
 		template <typename... Args>
-		constexpr void setParent(_pointer_iter it, Args&&... args) {
-			value = value_type(STD::forward<Args>(args)...); setParent(it);
+		constexpr void construct(Args&&... args) {
+			value = value_type(STD::forward<Args>(args)...);
 		}
 		// Avoid superfluous temporary if possible:
 		template <typename Arg>
-		constexpr auto setParent(_pointer_iter it, Arg&& arg)
+		constexpr auto construct(Arg&& arg)
 			-> require<STD::is_same<STD::decay_t<Arg>, value_type>> {
-			value = STD::forward<Arg>(arg); setParent(it);
+			value = STD::forward<Arg>(arg);
 		}
 	};
 
@@ -88,64 +86,74 @@ private:
 
 	private:
 		Node* _node;
+		index_type const* _index;
 
 		friend BasicStableVector;
 
 		friend constexpr _iterator_base<false> unconstifyIterator( BasicStableVector&, _iterator_base c ) {return c;}
 
-		constexpr explicit _iterator_base(Node* p) : _node(p) {}
+		constexpr _iterator_base(Node* p, index_type const* i) : _node(p), _index(i) {}
 
 		template <bool _const2, STD::enable_if_t<(_const2 > _const), int> = 0>
-		constexpr _iterator_base(_iterator_base<_const2> i) : _node(i._node) {}
+		constexpr _iterator_base(_iterator_base<_const2> i) : _node(i._node), _index(i._index) {}
+
+		constexpr size_type _position() const {return _index->position(_node);}
 
 	public:
 
 		template <bool _const2, STD::enable_if_t<(_const2 <= _const), long> = 0>
-		constexpr _iterator_base(_iterator_base<_const2> i) : _node(i._node) {}
+		constexpr _iterator_base(_iterator_base<_const2> i) : _node(i._node), _index(i._index) {}
 
-		constexpr _iterator_base(_iterator_base const& i) : _node(i._node) {}
+		constexpr _iterator_base(_iterator_base const& i) : _node(i._node), _index(i._index) {}
 
-		constexpr _iterator_base() : _iterator_base(nullptr) {}
+		constexpr _iterator_base() : _iterator_base(nullptr, nullptr) {}
 
 		constexpr reference operator*() const {return _node->value;}
 
-		constexpr _iterator_base& operator+=(difference_type d) {return *this = _iterator_base(_node->up[ d]);}
-		constexpr _iterator_base& operator-=(difference_type d) {return *this = _iterator_base(_node->up[-d]);}
+		constexpr _iterator_base& operator+=(difference_type d) {_node = _index->advance(_node,  d); return *this;}
+		constexpr _iterator_base& operator-=(difference_type d) {_node = _index->advance(_node, -d); return *this;}
 
 		constexpr _iterator_base& operator++() {return *this += 1;}
 		constexpr _iterator_base& operator--() {return *this -= 1;}
 
 		constexpr difference_type operator-(_iterator_base rhs) const {
-			return _node->up - rhs._node->up;
+			return difference_type(_position()) - difference_type(rhs._position());
 		}
 
 		constexpr bool operator==(_iterator_base rhs) const {return _node == rhs._node;}
-		constexpr bool operator <(_iterator_base rhs) const {return _node->up < rhs._node->up;}
+		constexpr bool operator <(_iterator_base rhs) const {return _position() < rhs._position();}
 	};
 
-	constexpr _pointer_iter _piter_of(const_iterator it) {return it._node->up;}
+	constexpr size_type _pos_of(const_iterator it) const {return _index.position(it._node);}
+	constexpr iterator _iter_at(size_type pos) const {return iterator(_index[pos], &_index);}
 
 public:
 
-	constexpr const_iterator  begin() const {return iterator(_pointers.front());}
-	constexpr const_iterator    end() const {return iterator(_pointers.back());}
-	constexpr       iterator  begin()       {return as_const(*this).begin();}
-	constexpr       iterator    end()       {return as_const(*this).end();}
+	constexpr const_iterator  begin() const {return _iter_at(0);}
+	constexpr const_iterator    end() const {return _iter_at(size());}
+	constexpr       iterator  begin()       {return _iter_at(0);}
+	constexpr       iterator    end()       {return _iter_at(size());}
 	constexpr const_iterator cbegin() const {return begin();}
 	constexpr const_iterator   cend() const {return end();}
 
 	constexpr       reverse_iterator  rbegin()       {return reverse_iterator(end());}
 	constexpr       reverse_iterator    rend()       {return reverse_iterator(begin());}
-	constexpr const_reverse_iterator  rbegin() const {return rbegin();}
-	constexpr const_reverse_iterator    rend() const {return rend();}
+	constexpr const_reverse_iterator  rbegin() const {return const_reverse_iterator(end());}
+	constexpr const_reverse_iterator    rend() const {return const_reverse_iterator(begin());}
 	constexpr const_reverse_iterator crbegin() const {return rbegin();}
 	constexpr const_reverse_iterator   crend() const {return rend();}
 
 private:
 
 	pool_type _pool {};
-	_pointer_container _pointers {&_endNode};
-	Node _endNode{{}, _pointers.begin()};
+	Node _endNode {};
+	index_type _index {};
+
+	constexpr void _reset() {
+		_index.clear();
+		_index.insert(0, 1);
+		_index.assign(0, &_endNode);
+	}
 
 	constexpr void _append(BasicStableVector const& s) {
 		insert(end(), s.begin(), s.end());
@@ -158,100 +166,103 @@ private:
 
 public:
 
-	constexpr void clear() {_pool.free(); _pointers.clear();}
+	constexpr void clear() {_pool.free(); _reset();}
 
-	constexpr size_type size() const {return _pointers.size()-1;}
+	constexpr size_type size() const {return _index.size()-1;}
 	constexpr bool     empty() const {return size() == 0;}
 
-	constexpr       reference front()       {return _pointers.front()->value;}
-	constexpr       reference  back()       {return _pointers. back()->value;}
-	constexpr const_reference front() const {return _pointers.front()->value;}
-	constexpr const_reference  back() const {return _pointers. back()->value;}
+	constexpr       reference front()       {return _index[0]->value;}
+	constexpr       reference  back()       {return _index[size()-1]->value;}
+	constexpr const_reference front() const {return _index[0]->value;}
+	constexpr const_reference  back() const {return _index[size()-1]->value;}
 
-	constexpr       reference operator[](size_type s)       {return _pointers[s]->value;}
-	constexpr const_reference operator[](size_type s) const {return _pointers[s]->value;}
+	constexpr       reference operator[](size_type s)       {return _index[s]->value;}
+	constexpr const_reference operator[](size_type s) const {return _index[s]->value;}
 
-	constexpr BasicStableVector() = default;
-	constexpr explicit BasicStableVector(size_type s)  {
+	constexpr BasicStableVector() {
+		_reset();
+	}
+	constexpr explicit BasicStableVector(size_type s) : BasicStableVector() {
 		resize(s);
 	}
-	constexpr BasicStableVector(size_type s, const_reference v)  {
+	constexpr BasicStableVector(size_type s, const_reference v) : BasicStableVector() {
 		insert(begin(), s, v);
 	}
 	template<typename InputIterator>
-	constexpr BasicStableVector(InputIterator first, InputIterator last) {
+	constexpr BasicStableVector(InputIterator first, InputIterator last) : BasicStableVector() {
 		insert(begin(), first, last);
 	}
 
 	constexpr BasicStableVector(STD::initializer_list<value_type> ilist) :
 		BasicStableVector(ilist.begin(), ilist.end()) {}
 
-	constexpr BasicStableVector(BasicStableVector const& s) {_append(s);}
-	constexpr BasicStableVector(BasicStableVector && s) {_append(STD::move(s));}
+	constexpr BasicStableVector(BasicStableVector const& s) : BasicStableVector() {_append(s);}
+	constexpr BasicStableVector(BasicStableVector && s) : BasicStableVector() {_append(STD::move(s));}
 
 	constexpr BasicStableVector& operator=(BasicStableVector const& s) {
 		clear(); _append(s);
+		return *this;
 	}
 	constexpr BasicStableVector& operator=(BasicStableVector && s) {
 		clear(); _append(STD::move(s));
+		return *this;
 	}
 
 private:
+	/**< Grabs and constructs a node before opening its slot at pos, so that a throwing pool leaves the index intact. */
 	template <typename... Args>
-	constexpr void _initialize( _pointer_iter it, Args&&... args) {
-		_pool.grab()->setParent(it, STD::forward<Args>(args)...);
+	constexpr void _initialize(size_type pos, Args&&... args) {
+		auto node = _pool.grab();
+		node->construct(STD::forward<Args>(args)...);
+		_index.insert(pos, 1);
+		_index.assign(pos, node);
 	}
 
-	// Shifts all elements in [it, _pointers.end()) by n elements to the right, so
-	// n empty are made available. The
-	constexpr void _shift(_pointer_iter it, size_type n) {
-		auto start = _pointers.end();
-		_pointers.resize(_pointers.size() + n);
-		while (start != it) {
-			--start;
-			(*start)->setParent(start+n);
-		}
+	constexpr detail::IndexCursor<index_type> _cursor(size_type pos) {return {_index, pos};}
+
+	/**< Opens n slots at pos and grabs n nodes into them. The nodes are written straight into the slots, so the
+	     pool's capacity is checked first: if it throws, the index is left untouched. */
+	constexpr void _grab_into(size_type pos, size_type n) {
+		AssertExcept<STD::bad_alloc>( n <= max_size() - size() );
+		_index.insert(pos, n);
+		_pool.grab_n(n, _cursor(pos));
 	}
 
 	template <typename InputIt>
-	constexpr void _insert_n(const_iterator it, size_type d, InputIt first) {
-		auto pointer_iter = it._node->up;
-		_shift(pointer_iter, d);
-		while (d--)
-			_initialize(pointer_iter++, *first++);
+	constexpr void _insert_n(size_type pos, size_type d, InputIt first) {
+		_grab_into(pos, d);
+		for (; d--; ++pos)
+			_index[pos]->construct(*first++);
 	}
 
 	template <typename ForwardIt>
-	constexpr void _insert(const_iterator it, ForwardIt first, ForwardIt last, STD::forward_iterator_tag) {
-		_insert_n(it, Constainer::distance(first, last), first);
+	constexpr void _insert(size_type pos, ForwardIt first, ForwardIt last, STD::forward_iterator_tag) {
+		_insert_n(pos, Constainer::distance(first, last), first);
 	}
 
-	template <typename ForwardIt>
-	constexpr void _insert(const_iterator it, ForwardIt first, ForwardIt last, STD::input_iterator_tag) {
-		auto pointer_iter = it._node->up;
-		while (first != last) {
-			_shift(it, 1);
-			_initialize(pointer_iter++, *first++);
+	template <typename InputIt>
+	constexpr void _insert(size_type pos, InputIt first, InputIt last, STD::input_iterator_tag) {
+		for (; first != last; ++pos) {
+			_initialize(pos, *first++);
 		}
 	}
 
 	template <typename... Args>
 	constexpr iterator _insert_repeat(const_iterator it, size_type n, Args const&... args) {
-		auto pointer_iter = _piter_of(it);
-		_shift(pointer_iter, n);
-		while (n--)
-			_initialize(pointer_iter++, args...);
-		return it;
+		auto pos = _pos_of(it);
+		_grab_into(pos, n);
+		for (auto i = pos; i != pos+n; ++i)
+			_index[i]->construct(args...);
+		return _iter_at(pos);
 	}
 
 public:
 
 	template <typename... Args>
 	constexpr iterator emplace(const_iterator it, Args&&... args) {
-		auto pointer_iter = _piter_of(it);
-		_shift(pointer_iter, 1);
-		_initialize(pointer_iter, STD::forward<Args>(args)...);
-		return it;
+		auto pos = _pos_of(it);
+		_initialize(pos, STD::forward<Args>(args)...);
+		return _iter_at(pos);
 	}
 
 	constexpr iterator insert(const_iterator it, const_reference v) {return emplace(it, v);}
@@ -263,20 +274,21 @@ public:
 	template <typename InputIterator>
 	constexpr require<isInputIterator<InputIterator>, iterator>
 	insert(const_iterator it, InputIterator first, InputIterator last) {
-		_insert(it, first, last, typename STD::iterator_traits<InputIterator>::iterator_category{});
-		return it;
+		auto pos = _pos_of(it);
+		_insert(pos, first, last, typename STD::iterator_traits<InputIterator>::iterator_category{});
+		return _iter_at(pos);
 	}
 	/**< Inserts [first, first+d). Useful if InputIterator is an input iterator only. */
 	template <typename InputIterator>
 	constexpr require<isInputIterator<InputIterator>, iterator>
 	insert(const_iterator it, size_type d, InputIterator first) {
-		_insert_n(it, d, first);
-		return it;
+		auto pos = _pos_of(it);
+		_insert_n(pos, d, first);
+		return _iter_at(pos);
 	}
 
 	constexpr iterator insert(const_iterator it, STD::initializer_list<value_type> ilist) {
-		_insert(it, ilist.begin(), ilist.end(), STD::random_access_iterator_tag{});
-		return it;
+		return insert(it, ilist.begin(), ilist.end());
 	}
 
 	constexpr void push_back( const_reference x ) {insert(end(), x);}
@@ -288,21 +300,16 @@ public:
 	}
 
 	constexpr iterator erase(const_iterator first, const_iterator last) {
-		auto pfirst=_piter_of(first), plast=_piter_of(last);
-		for (auto i = pfirst; i != plast; ++i)
-			_pool.free(*i++);
-		_pointers.erase(pfirst, plast);
-		for (; pfirst != _pointers.end(); ++pfirst)
-			(*pfirst)->up = pfirst;
-		return first;
+		auto pfirst = _pos_of(first), plast = _pos_of(last);
+		_pool.free_n(_cursor(pfirst), plast-pfirst);
+		_index.erase(pfirst, plast-pfirst);
+		return _iter_at(pfirst);
 	}
 	constexpr iterator erase(const_iterator i) {
-		auto pi = _piter_of(i);
-		_pool.free(*pi);
-		_pointers.erase(pi);
-		while (pi != _pointers.end())
-			--(*pi++)->up;
-		return i;
+		auto pos = _pos_of(i);
+		_pool.free(_index[pos]);
+		_index.erase(pos, 1);
+		return _iter_at(pos);
 	}
 
 	constexpr void resize(size_type s) {
@@ -317,6 +324,10 @@ public:
 template <typename T, STD::size_t MaxN=defaultContainerSize>
 using StableVector = BasicStableVector<T, ChunkPool<T, MaxN>>;
 
+/**< A StableVector for frequent insertion and erasure in the middle. */
+template <typename T, STD::size_t MaxN=defaultContainerSize>
+using TieredStableVector = BasicStableVector<T, ChunkPool<T, MaxN>, TieredIndex<>>;
+
 template <typename... A1, typename... A2>
 constexpr bool operator==(BasicStableVector<A1...> const& lhs, BasicStableVector<A2...> const& rhs) {
 	return lhs.size() == rhs.size() && Constainer::equal(lhs.begin(), lhs.end(), rhs.begin());
@@ -0,0 +1,243 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+#include "Array.hxx"
+#include "Assert.hxx"
+#include "Vector.hxx"
+
+namespace Constainer {
+
+/**< Index policies determine how BasicStableVector maps positions to its nodes. A policy is rebound to the node
+     type and the capacity (including the end node); the resulting index stores Node pointers and keeps the member
+     up of every node pointing at the slot that holds it. Inserted slots are unspecified until assigned. */
+
+namespace detail {
+	/**< One contiguous array of node pointers. Random access and iterator arithmetic are a single indirection,
+	     but insertion and erasure move every subsequent pointer. */
+	template <typename Node, STD::size_t N>
+	class FlatNodeIndex {
+	public:
+		using size_type = STD::size_t;
+		using difference_type = STD::ptrdiff_t;
+
+	private:
+		Vector<Node*, N> _slots;
+
+		constexpr void _move(size_type to, size_type from) {
+			assign(to, _slots[from]);
+		}
+
+	public:
+		constexpr size_type size() const {return _slots.size();}
+
+		constexpr Node* operator[](size_type i) const {return _slots[i];}
+
+		constexpr void assign(size_type i, Node* node) {
+			auto& slot = _slots[i];
+			slot = node;
+			node->up = &slot;
+		}
+
+		constexpr size_type position(Node const* node) const {return node->up - _slots.data();}
+		constexpr Node* advance(Node const* node, difference_type d) const {return node->up[d];}
+
+		constexpr void insert(size_type pos, size_type n) {
+			auto i = size();
+			_slots.resize(size() + n);
+			while (i-- != pos)
+				_move(i+n, i);
+		}
+		constexpr void erase(size_type pos, size_type n) {
+			for (auto i = pos+n; i != size(); ++i)
+				_move(i-n, i);
+			_slots.resize(size() - n);
+		}
+		constexpr void clear() {_slots.clear();}
+	};
+
+	/**< A tiered vector: the slots are split into blocks of BlockSize, each of which is a circular buffer. All blocks
+	     but the last are full, so position i is at offset i%BlockSize of block i/BlockSize, relative to the head of that
+	     block. Inserting or erasing a single position shifts at most half a block and then passes one pointer across
+	     each subsequent block boundary by rotating the heads, which is O(sqrt(N)) for the default block size. */
+	template <typename Node, STD::size_t N, STD::size_t BlockSize>
+	class TieredNodeIndex {
+		static_assert( BlockSize != 0 && (BlockSize & (BlockSize-1)) == 0, "Block size must be a power of two" );
+
+	public:
+		using size_type = STD::size_t;
+		using difference_type = STD::ptrdiff_t;
+
+	private:
+		static constexpr size_type _blocks = (N + BlockSize-1) / BlockSize;
+		static constexpr size_type _mask = BlockSize-1;
+
+		Array<Node*, _blocks*BlockSize> _slots{};
+		Array<size_type, _blocks> _heads{};
+		size_type _size = 0;
+
+		constexpr size_type _physical(size_type block, size_type offset) const {
+			return block*BlockSize + ((_heads[block] + offset) & _mask);
+		}
+
+		constexpr void _assign(size_type phys, Node* node) {
+			auto& slot = _slots[phys];
+			slot = node;
+			// Gaps opened by a previous _insert_one hold null.
+			if (node)
+				node->up = &slot;
+		}
+		constexpr void _move(size_type to_block, size_type to_offset, size_type from_block, size_type from_offset) {
+			_assign(_physical(to_block, to_offset), _slots[_physical(from_block, from_offset)]);
+		}
+		constexpr void _move(size_type to, size_type from) {
+			_move(to/BlockSize, to%BlockSize, from/BlockSize, from%BlockSize);
+		}
+
+		constexpr void _insert_one(size_type pos) {
+			auto target = pos/BlockSize, offset = pos%BlockSize;
+			// Block that receives the new last position
+			auto last = _size/BlockSize;
+			// Each following block passes its last pointer on and takes the last one of its predecessor.
+			for (auto b = last; b != target; --b) {
+				_heads[b] = (_heads[b]-1) & _mask;
+				_move(b, 0, b-1, BlockSize-1);
+			}
+			// The target block's last offset is free now; open the gap by shifting the shorter side.
+			auto count = target == last? _size - target*BlockSize : BlockSize-1;
+			if (offset < count - offset) {
+				_heads[target] = (_heads[target]-1) & _mask;
+				for (size_type k = 0; k != offset; ++k)
+					_move(target, k, target, k+1);
+			}
+			else
+				for (auto k = count; k-- != offset;)
+					_move(target, k+1, target, k);
+			_slots[_physical(target, offset)] = nullptr;
+			++_size;
+		}
+
+		constexpr void _erase_one(size_type pos) {
+			auto target = pos/BlockSize, offset = pos%BlockSize;
+			auto last = (_size-1)/BlockSize;
+			auto count = target == last? _size - target*BlockSize : BlockSize;
+			// Close the gap by shifting the shorter side, leaving the last offset free.
+			if (offset < count-1 - offset) {
+				for (auto k = offset; k-- != 0;)
+					_move(target, k+1, target, k);
+				_heads[target] = (_heads[target]+1) & _mask;
+			}
+			else
+				for (auto k = offset+1; k != count; ++k)
+					_move(target, k-1, target, k);
+			for (auto b = target+1; b <= last; ++b) {
+				_move(b-1, BlockSize-1, b, 0);
+				_heads[b] = (_heads[b]+1) & _mask;
+			}
+			--_size;
+		}
+
+		/**< Whether moving n positions one at a time is cheaper than moving everything after pos by n. */
+		constexpr bool _stepwise(size_type pos, size_type n) const {
+			return n * (BlockSize/2 + (_size-pos)/BlockSize + 1) < _size-pos;
+		}
+
+	public:
+		constexpr size_type size() const {return _size;}
+
+		constexpr Node* operator[](size_type i) const {return _slots[_physical(i/BlockSize, i%BlockSize)];}
+
+		constexpr void assign(size_type i, Node* node) {
+			_assign(_physical(i/BlockSize, i%BlockSize), node);
+		}
+
+		constexpr size_type position(Node const* node) const {
+			size_type phys = node->up - _slots.data();
+			auto block = phys/BlockSize;
+			return block*BlockSize + ((phys - _heads[block]) & _mask);
+		}
+		constexpr Node* advance(Node const* node, difference_type d) const {
+			return (*this)[position(node) + d];
+		}
+
+		constexpr void insert(size_type pos, size_type n) {
+			AssertExcept<STD::length_error>( n <= N - _size, "Invalid attempt to increase container size" );
+			if (_stepwise(pos, n))
+				while (n--)
+					_insert_one(pos);
+			else {
+				for (auto i = _size; i-- != pos;)
+					_move(i+n, i);
+				_size += n;
+			}
+		}
+		constexpr void erase(size_type pos, size_type n) {
+			if (_stepwise(pos, n))
+				while (n--)
+					_erase_one(pos);
+			else {
+				for (auto i = pos+n; i != _size; ++i)
+					_move(i-n, i);
+				_size -= n;
+			}
+		}
+		constexpr void clear() {_size = 0;}
+	};
+
+	/**< Walks the slots of an index from a position on, so that pools can grab nodes into a range of slots and free
+	     the nodes of a range of slots in bulk: *cursor++ = node assigns a slot, and *cursor++ reads one. */
+	template <typename Index>
+	class IndexCursor {
+		using node_pointer = decltype(STD::declval<Index const&>()[0]);
+
+		struct Slot {
+			Index* index;
+			STD::size_t pos;
+
+			constexpr operator node_pointer() const {return (*index)[pos];}
+			constexpr Slot const& operator=(node_pointer node) const {
+				index->assign(pos, node);
+				return *this;
+			}
+		};
+
+		Index* _index;
+		STD::size_t _pos;
+
+	public:
+		constexpr IndexCursor(Index& index, STD::size_t pos) : _index(&index), _pos(pos) {}
+
+		constexpr Slot operator*() const {return {_index, _pos};}
+		constexpr IndexCursor& operator++() {++_pos; return *this;}
+		constexpr IndexCursor operator++(int) {
+			auto tmp = *this;
+			++_pos;
+			return tmp;
+		}
+	};
+
+	constexpr STD::size_t defaultBlockSize(STD::size_t n) {
+		STD::size_t b = 8;
+		while (b*b < n)
+			b *= 2;
+		return b;
+	}
+}
+
+/**< Keeps all node pointers in one array. Best for small vectors and mostly appending use. */
+struct FlatIndex {
+	template <typename Node, STD::size_t N>
+	using rebind = detail::FlatNodeIndex<Node, N>;
+};
+
+/**< Keeps the node pointers in a tiered vector, making insertion and erasure in the middle O(sqrt(N)) instead
+     of O(N), at the price of some arithmetic per random access. BlockSize defaults to about sqrt(N). */
+template <STD::size_t BlockSize = 0>
+struct TieredIndex {
+	template <typename Node, STD::size_t N>
+	using rebind = detail::TieredNodeIndex<Node, N, BlockSize != 0? BlockSize : detail::defaultBlockSize(N)>;
+};
+
+}
@@ -0,0 +1,45 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+#include "FlatMap.hxx"
+#include "StaticHashTable.hxx"
+
+namespace Constainer {
+
+namespace detail {
+template <typename Key, typename Mapped, typename Hash, typename KeyEqual, STD::size_t MaxN>
+class BasicStaticHashMap
+	: public      StaticHashTable<Key, ConstKeyPair<Key, Mapped>,
+	                              typename ConstKeyPair<Key, Mapped>::KeyOfPair, Hash, KeyEqual, MaxN> {
+	using _base = StaticHashTable<Key, ConstKeyPair<Key, Mapped>,
+	                              typename ConstKeyPair<Key, Mapped>::KeyOfPair, Hash, KeyEqual, MaxN>;
+
+public:
+	using _base::_base;
+
+	using mapped_type = Mapped;
+
+	using typename _base::key_type;
+
+	constexpr       Mapped& at(key_type const& key) {
+		auto pos = this->find(key);
+		AssertExcept<STD::out_of_range>(pos != this->end(), "");
+		return pos->value();
+	}
+	constexpr Mapped const& at(key_type const& key) const {
+		auto pos = this->find(key);
+		AssertExcept<STD::out_of_range>(pos != this->cend(), "");
+		return pos->value();
+	}
+};
+}
+
+/**< Use e.g. StaticHashMap<…>(someFlatMap) to obtain constant-time lookup on a table that is computed at compile-time. */
+template <typename K, typename V, STD::size_t MaxN=defaultContainerSize,
+          typename Hash = StaticHash<K>, typename KeyEqual = STD::equal_to<K>>
+using StaticHashMap = detail::BasicStaticHashMap<K, V, Hash, KeyEqual, MaxN>;
+
+}
@@ -0,0 +1,15 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+#include "StaticHashTable.hxx"
+
+namespace Constainer {
+
+template <typename T, STD::size_t MaxN=defaultContainerSize,
+          typename Hash = StaticHash<T>, typename KeyEqual = STD::equal_to<T>>
+using StaticHashSet = detail::StaticHashTable<T, T, IdentityFunctor, Hash, KeyEqual, MaxN>;
+
+}
@@ -0,0 +1,270 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt)
+
+	The construction follows the "hash, displace and compress" scheme by Belazzougui, Botelho and Dietzfelbinger. */
+
+#pragma once
+
+#include "Algorithms.hxx"
+#include "Bitset.hxx"
+#include "String.hxx"
+#include "Vector.hxx"
+
+#include <cstdint>
+#include <functional>
+
+namespace Constainer {
+
+/**< A hash function usable in constant expressions. Unlike STD::hash, the result is not expected
+     to be well distributed; StaticHashTable scrambles it before use. */
+template <typename T>
+struct StaticHash {
+	static_assert( STD::is_integral<T>{} || STD::is_enum<T>{},
+	               "StaticHash must be specialized for non-integral key types" );
+
+	CONSTAINER_PURE_CONST constexpr STD::uint64_t operator()(T t) const {
+		return static_cast<STD::uint64_t>(t);
+	}
+};
+
+/**< FNV-1a over the characters of the string. */
+template <typename CharT, STD::size_t MaxN, typename Traits>
+struct StaticHash<BasicString<CharT, MaxN, Traits>> {
+	CONSTAINER_PURE constexpr STD::uint64_t operator()(BasicString<CharT, MaxN, Traits> const& str) const {
+		STD::uint64_t h = 0xcbf29ce484222325;
+		for (auto c : str) {
+			h ^= static_cast<STD::uint64_t>(Traits::to_int_type(c));
+			h *= 0x100000001b3;
+		}
+		return h;
+	}
+};
+
+namespace detail {
+
+/**< Immutable hash table with a perfect hash function computed upon construction. Every lookup costs exactly
+     two applications of the scrambler, two table loads and one key comparison.
+     Keys are distributed into size() buckets; each bucket is assigned a seed such that all of its keys are
+     sent to unoccupied slots among size() slots. Buckets are handled in descending order of size, which makes the search
+     for seeds quick even if the table is full, i.e. the hash function is minimal.
+     Elements are stored contiguously in the order they were passed in, such that iteration over
+     a table constructed from a FlatTree is in sorted order. */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash, typename KeyEqual, STD::size_t MaxN>
+class StaticHashTable
+{
+public:
+	using key_type    = Key;
+	using value_type  = Value;
+	using hasher      = Hash;
+	using key_equal   = KeyEqual;
+
+private:
+	static constexpr bool _constIterator = STD::is_same<Key, Value>::value;
+
+public:
+
+	using container_type = Vector<value_type, MaxN>;
+
+	using pointer         = typename container_type::pointer;
+	using const_pointer   = typename container_type::const_pointer;
+	using reference       = typename container_type::reference;
+	using const_reference = typename container_type::const_reference;
+	using size_type       = typename container_type::size_type;
+	using difference_type = typename container_type::difference_type;
+
+	// Keys of a set must not be modified, as they determine the slots.
+	using const_iterator         = typename container_type::const_iterator;
+	using iterator               = STD::conditional_t<_constIterator, const_iterator, typename container_type::iterator>;
+	using const_reverse_iterator = typename container_type::const_reverse_iterator;
+	using reverse_iterator       = STD::conditional_t<_constIterator, const_reverse_iterator,
+	                                                  typename container_type::reverse_iterator>;
+
+private:
+	using _index_type = STD::conditional_t<(MaxN <= 0xFF),   STD::uint8_t,
+	                    STD::conditional_t<(MaxN <= 0xFFFF), STD::uint16_t, STD::uint32_t>>;
+	using _seed_type = STD::uint32_t;
+
+	container_type _values;
+	// Only the first size() slots and seeds are used. Every slot is occupied, except in an empty table,
+	// where the only slot refers to no element.
+	Array<_index_type, MaxN> _slots;
+	Array<_seed_type, MaxN> _seeds;
+	hasher _hasher;
+	key_equal _key_equal;
+
+	/**< The finalizer of splitmix64. */
+	CONSTAINER_PURE_CONST static constexpr STD::uint64_t _scramble(STD::uint64_t z) {
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+		return z ^ (z >> 31);
+	}
+	/**< The number of buckets, which is also the number of slots. */
+	constexpr size_type _table_size() const {return empty()? 1 : size();}
+	constexpr size_type _bucket(STD::uint64_t h) const {
+		return _scramble(h) % _table_size();
+	}
+	constexpr size_type _slot(STD::uint64_t h, _seed_type seed) const {
+		return _scramble(h + seed*0x9e3779b97f4a7c15) % _table_size();
+	}
+
+	constexpr decltype(auto) _key_of(size_type i) const {return KeyOfValue()(_values.begin()[i]);}
+
+	constexpr size_type _index_of(key_type const& key) const {
+		auto h = _hasher(key);
+		size_type i = _slots[_slot(h, _seeds[_bucket(h)])];
+		return i < size() && _key_equal(_key_of(i), key)? i : size();
+	}
+
+	/**< Sorts the element indices by bucket. members[start[b]], ..., members[start[b+1]-1] are the elements of bucket b. */
+	constexpr void _distribute(Array<STD::uint64_t, MaxN>& hashes, Array<size_type, MaxN>& members,
+	                           Array<size_type, MaxN+1>& start) const {
+		start.fill(0);
+		for (size_type i = 0; i != size(); ++i) {
+			hashes[i] = _hasher(_key_of(i));
+			++start[_bucket(hashes[i])+1];
+		}
+		Constainer::partial_sum(start.begin(), start.begin()+_table_size()+1, start.begin());
+		Array<size_type, MaxN> pos{};
+		for (size_type i = 0; i != size(); ++i) {
+			auto b = _bucket(hashes[i]);
+			members[start[b] + pos[b]++] = i;
+		}
+	}
+
+	/**< Erases all but the first occurence of each key. Returns whether any element was erased. */
+	constexpr bool _remove_duplicates(Array<STD::uint64_t, MaxN> const& hashes, Array<size_type, MaxN> const& members,
+	                                  Array<size_type, MaxN+1> const& start) {
+		Bitset<MaxN> dup;
+		for (size_type b = 0; b != _table_size(); ++b)
+			for (auto i = start[b]; i != start[b+1]; ++i)
+				for (auto j = start[b]; j != i; ++j) {
+					auto first = members[j], second = members[i];
+					if (hashes[first] != hashes[second] || dup.test(first))
+						continue;
+					AssertExcept<STD::invalid_argument>(_key_equal(_key_of(first), _key_of(second)),
+					                                    "Distinct keys with identical hash values");
+					dup.set(second);
+					break;
+				}
+
+		if (dup.none())
+			return false;
+
+		size_type n = 0;
+		for (size_type i = 0; i != size(); ++i)
+			if (!dup.test(i))
+				_values[n++] = STD::move(_values[i]);
+		_values.erase(_values.begin()+n, _values.end());
+		return true;
+	}
+
+	constexpr void _build() {
+		Array<STD::uint64_t, MaxN> hashes{};
+		Array<size_type, MaxN> members{};
+		Array<size_type, MaxN+1> start{};
+		do
+			_distribute(hashes, members, start);
+		while (_remove_duplicates(hashes, members, start));
+
+		// Counting sort of the buckets, largest first.
+		auto const n = _table_size();
+		Array<size_type, MaxN+2> by_size{};
+		for (size_type b = 0; b != n; ++b)
+			++by_size[n - (start[b+1]-start[b]) + 1];
+		Constainer::partial_sum(by_size.begin(), by_size.begin()+n+2, by_size.begin());
+		Array<size_type, MaxN> order{};
+		for (size_type b = 0; b != n; ++b)
+			order[by_size[n - (start[b+1]-start[b])]++] = b;
+
+		Bitset<MaxN> occupied;
+		Array<size_type, MaxN> slots{};
+		for (size_type k = 0; k != n; ++k) {
+			auto b = order[k];
+			auto first = start[b], last = start[b+1];
+			if (first == last)
+				break;
+
+			for (_seed_type seed = 1;; ++seed) {
+				AssertExcept<STD::logic_error>(seed != 0, "No perfect hash function found");
+				auto i = first;
+				for (; i != last; ++i) {
+					slots[i] = _slot(hashes[members[i]], seed);
+					if (occupied.test(slots[i]))
+						break;
+					occupied.set(slots[i]);
+				}
+				if (i == last) {
+					_seeds[b] = seed;
+					break;
+				}
+				while (i-- != first)
+					occupied.reset(slots[i]);
+			}
+			for (auto i = first; i != last; ++i)
+				_slots[slots[i]] = members[i];
+		}
+	}
+
+public:
+
+	constexpr StaticHashTable() : _values{}, _slots{}, _seeds{}, _hasher{}, _key_equal{} {}
+
+	template <typename InputIt>
+	constexpr StaticHashTable(InputIt first, InputIt last, hasher const& hash = hasher(), key_equal const& eq = key_equal())
+		: _values(first, last), _slots{}, _seeds{}, _hasher(hash), _key_equal(eq) {
+		_build();
+	}
+
+	constexpr StaticHashTable(STD::initializer_list<value_type> ilist, hasher const& hash = hasher(), key_equal const& eq = key_equal())
+		: StaticHashTable(ilist.begin(), ilist.end(), hash, eq) {}
+
+	/**< Builds the table from a FlatTree-based container (e.g. a FlatMap or FlatSet) or any other range. */
+	template <typename Range, typename=decltype(STD::declval<Range const&>().begin())>
+	constexpr explicit StaticHashTable(Range const& range, hasher const& hash = hasher(), key_equal const& eq = key_equal())
+		: StaticHashTable(range.begin(), range.end(), hash, eq) {}
+
+	constexpr hasher hash_function() const {return _hasher;}
+	constexpr key_equal key_eq() const {return _key_equal;}
+
+	constexpr         bool empty() const {return _values.empty();}
+	constexpr size_type     size() const {return _values.size();}
+	static constexpr size_type max_size() {return container_type::max_size();}
+
+	constexpr       iterator  begin()       {return _values.begin();}
+	constexpr       iterator    end()       {return _values.end();}
+	constexpr const_iterator  begin() const {return _values.begin();}
+	constexpr const_iterator    end() const {return _values.end();}
+	constexpr const_iterator cbegin() const {return begin();}
+	constexpr const_iterator   cend() const {return end();}
+
+	constexpr       reverse_iterator  rbegin()       {return _values.rbegin();}
+	constexpr       reverse_iterator    rend()       {return _values.rend();}
+	constexpr const_reverse_iterator  rbegin() const {return _values.rbegin();}
+	constexpr const_reverse_iterator    rend() const {return _values.rend();}
+	constexpr const_reverse_iterator crbegin() const {return rbegin();}
+	constexpr const_reverse_iterator   crend() const {return rend();}
+
+	constexpr       iterator find(key_type const& key)       {return begin() + _index_of(key);}
+	constexpr const_iterator find(key_type const& key) const {return begin() + _index_of(key);}
+
+	constexpr size_type count(key_type const& key) const {return _index_of(key) != size();}
+	constexpr bool   contains(key_type const& key) const {return _index_of(key) != size();}
+
+	constexpr       iterator nth(size_type i)       {return begin() + i;}
+	constexpr const_iterator nth(size_type i) const {return cbegin() + i;}
+	constexpr size_type index_of(const_iterator i) const {return i-cbegin();}
+};
+
+template <typename... Args1, typename... Args2>
+constexpr bool operator==(StaticHashTable<Args1...> const& lhs, StaticHashTable<Args2...> const& rhs) {
+	return lhs.size() == rhs.size() && Constainer::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+template <typename... Args1, typename... Args2>
+constexpr bool operator!=(StaticHashTable<Args1...> const& lhs, StaticHashTable<Args2...> const& rhs) {
+	return !(lhs == rhs);
+}
+
+} // end namespace Constainer::detail
+
+} // end namespace Constainer
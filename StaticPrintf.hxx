@@ -5,31 +5,16 @@
 #pragma once
 
 #include "String.hxx"
-#include "Stack.hxx"
 #include "Math.hxx"
 #include "RangeAccess.hxx"
+#include "impl/FloatConversion.hxx"
 
+#include <ostream>
+#include <tuple>
 #include <type_traits>
 
 namespace Constainer { namespace detail {
 
-template <typename StringType, typename T, typename P>
-constexpr require<STD::is_floating_point<T>> writeDigitsReversed ( StringType& str, T t, int base, P digits ) {
-	do {
-		str += digits[ (STD::size_t) remainder (t, base)];
-		t /= base;
-	}
-	while (t >= 1 || t <= -1);
-}
-template <typename StringType, typename T, typename P>
-constexpr require<STD::is_integral<T>> writeDigitsReversed ( StringType& str, T t, int base, P digits ) {
-	do {
-		str += digits[t % base];
-		t /= base;
-	}
-	while (t != 0);
-}
-
 template <typename Char>
 struct DefaultTokens;
 template <>
@@ -53,9 +38,6 @@ struct DefaultTokens<char> {
 	static constexpr char const *lowerInf = "inf", *upperInf = "INF",
 	                            *lowerNaN = "nan", *upperNaN = "NAN";
 
-	static constexpr char const *lowerHexPrefixReversed = "x0", *upperHexPrefixReversed = "X0";
-
-
 	static constexpr char const* get_digits (bool upper) {
 		return (char const*) "0123456789abcdef0123456789ABCDEF" + upper*16;
 	}
@@ -66,19 +48,116 @@ struct DefaultTokens<char> {
 };
 
 
-/**< The class template surrounding the parser utility and parametrising character type and tokens. */
-template <typename CharT, typename Tokens=DefaultTokens<CharT>, typename Traits=CharTraits<CharT>>
-struct Parser {
+/**< Output iterators for formatted output. The formatter writes runs of characters through putN and fillN, which
+     iterators with append members implement in bulk. */
 
-	enum class IndexConsistency {NoCommitment, Running, NotRunning};
+/**< Appends to a string, such as a BasicString. */
+template <typename StringType>
+class StringAppender {
+	StringType* _str;
+
+public:
+	using iterator_category = STD::output_iterator_tag;
+	typedef void value_type, difference_type, pointer, reference;
+
+	constexpr explicit StringAppender(StringType& str) : _str(&str) {}
 
-	template <IndexConsistency C> static constexpr void _assertRunning() {
-		static_assert(C == IndexConsistency::NoCommitment || C == IndexConsistency::   Running, "Can't interchangeably use running and specified indices!");
+	constexpr StringAppender& operator*()     {return *this;}
+	constexpr StringAppender& operator++()    {return *this;}
+	constexpr StringAppender& operator++(int) {return *this;}
+
+	constexpr StringAppender& operator=(typename StringType::value_type c) {
+		_str->push_back(c);
+		return *this;
 	}
-	template <IndexConsistency C> static constexpr void _assertNotRunning() {
-		static_assert(C == IndexConsistency::NoCommitment || C == IndexConsistency::NotRunning, "Can't interchangeably use running and specified indices!");
+
+	template <typename CharT>
+	constexpr void append(CharT const* s, STD::size_t count) {_str->append(s, count);}
+	template <typename CharT>
+	constexpr void append(STD::size_t count, CharT c) {_str->append(count, c);}
+};
+
+/**< Writes to a buffer of the given capacity. Characters beyond it are counted, but dropped. */
+template <typename CharT>
+class BoundedWriter {
+	CharT* _pos;
+	STD::size_t _space;
+	STD::size_t _count = 0;
+
+public:
+	using iterator_category = STD::output_iterator_tag;
+	typedef void value_type, difference_type, pointer, reference;
+
+	constexpr BoundedWriter(CharT* first, STD::size_t capacity) : _pos(first), _space(capacity) {}
+
+	/**< The number of characters written, including the dropped ones. */
+	constexpr STD::size_t count() const {return _count;}
+
+	constexpr BoundedWriter& operator*()     {return *this;}
+	constexpr BoundedWriter& operator++()    {return *this;}
+	constexpr BoundedWriter& operator++(int) {return *this;}
+
+	constexpr BoundedWriter& operator=(CharT c) {
+		if (_space != 0) {
+			*_pos++ = c;
+			--_space;
+		}
+		++_count;
+		return *this;
 	}
 
+	constexpr void append(CharT const* s, STD::size_t count) {
+		auto n = STD::min(count, _space);
+		_pos = Constainer::copy_n(s, n, _pos);
+		_space -= n;
+		_count += count;
+	}
+	constexpr void append(STD::size_t count, CharT c) {
+		auto n = STD::min(count, _space);
+		_pos = Constainer::fill_n(_pos, n, c);
+		_space -= n;
+		_count += count;
+	}
+};
+
+template <typename OutputIt, typename CharT>
+constexpr auto putN(rank<0>, OutputIt out, CharT const* s, STD::size_t count) -> STD::decay_t<decltype(out.append(s, count), out)> {
+	out.append(s, count);
+	return out;
+}
+template <typename OutputIt, typename CharT>
+constexpr OutputIt putN(rank<1>, OutputIt out, CharT const* s, STD::size_t count) {
+	return Constainer::copy_n(s, count, out);
+}
+/**< Writes [s, s+count) to out. */
+template <typename OutputIt, typename CharT>
+constexpr OutputIt putN(OutputIt out, CharT const* s, STD::size_t count) {
+	return putN(rank<0>{}, out, s, count);
+}
+
+template <typename OutputIt, typename CharT>
+constexpr auto fillN(rank<0>, OutputIt out, STD::size_t count, CharT c) -> STD::decay_t<decltype(out.append(count, c), out)> {
+	out.append(count, c);
+	return out;
+}
+template <typename OutputIt, typename CharT>
+constexpr OutputIt fillN(rank<1>, OutputIt out, STD::size_t count, CharT c) {
+	return Constainer::fill_n(out, count, c);
+}
+/**< Writes count copies of c to out. */
+template <typename OutputIt, typename CharT>
+constexpr OutputIt fillN(OutputIt out, STD::size_t count, CharT c) {
+	return fillN(rank<0>{}, out, count, c);
+}
+
+/**< The class template surrounding the parser utility and parametrising character type and tokens.
+     A format string is compiled into segments once, each of which consists of literal text and an optional
+     conversion. Formatting writes the segments straight to an output iterator. */
+template <typename CharT, typename Tokens=DefaultTokens<CharT>, typename Traits=CharTraits<CharT>>
+struct Parser {
+
+	enum class IndexConsistency {NoCommitment, Running, NotRunning};
+
 	struct Info
 	{
 		int width = 0, precision = -1;
@@ -93,23 +172,43 @@ struct Parser {
 		bool upper = false;
 	};
 
+	static constexpr STD::size_t none = -1;
+
+	/**< Literal text, given as a range of the format string, followed by a conversion unless conversion is '\0'. */
+	struct Segment : Info
+	{
+		STD::size_t literal = 0, literal_length = 0;
+		CharT conversion = '\0';
+		/**< The indices of the converted argument and of the arguments supplying width and precision, if any */
+		STD::size_t arg = none, width_arg = none, precision_arg = none;
+	};
+
+	template <STD::size_t N>
+	struct CompiledFormat
+	{
+		Array<Segment, N> segments{};
+		STD::size_t size = 0;
+		bool valid = true;
+		bool consistent = true;
+	};
+
 	template <typename Stream>
-	static constexpr void applyInfoToStream( Stream& stream, Info const& info ) {
-		stream.precision(info.precision);
+	static void applyInfoToStream( Stream& stream, Info const& info ) {
+		if (info.precision >= 0)
+			stream.precision(info.precision);
 		stream.width(info.width);
 		stream.fill(info.pad);
 
-		// This is not necessary, as we pad the field ourselves
-		/*switch (info.alignment) {
+		switch (info.alignment) {
 		case Info::left_justified:
 			stream.setf(Stream::left, Stream::adjustfield);
 		break;
-		case Info::right_justified: case Info::central:
-			stream.setf(Stream::right, Stream::adjustfield);
-		break;
-		default: // Info::internal
+		case Info::internal:
 			stream.setf(Stream::internal, Stream::adjustfield);
-		};*/
+		break;
+		default: // Streams cannot center
+			stream.setf(Stream::right, Stream::adjustfield);
+		};
 
 		if (info.upper)
 			stream.setf(Stream::uppercase);
@@ -121,753 +220,409 @@ struct Parser {
 		else /*info.base == 8*/ stream.setf(Stream::oct, Stream::basefield);
 	}
 
-	template <typename StringType>
-	static constexpr void pad_central ( StringType& str, typename StringType::size_type needed , CharT c ) {
-		str.append (needed/2, c);
-		str.insert (0, (needed+1)/2, c);
+	static constexpr bool isFloatConversion(CharT c) {
+		return c == Tokens::lowerExp      || c == Tokens::upperExp
+		    || c == Tokens::lowerFixed    || c == Tokens::upperFixed
+		    || c == Tokens::lowerHybrid   || c == Tokens::upperHybrid
+		    || c == Tokens::lowerHexfloat || c == Tokens::upperHexfloat;
+	}
+	static constexpr bool isIntegerConversion(CharT c) {
+		return c == Tokens::decimalInt || c == Tokens::signedInt || c == Tokens::unsignedInt
+		    || c == Tokens::lowerHex   || c == Tokens::upperHex  || c == Tokens::octal
+		    || c == Tokens::character;
 	}
 
-	template <typename StringType>
-	static constexpr void pad_unformatted ( StringType& str, Info const& info )
-	{
-		if (str.size() < (STD::size_t)info.width) {
-			auto needed = info.width - str.size();
-			switch (info.alignment) {
-				case Info::left_justified:
-					str.append (needed, info.pad);
-				break;
-				case Info::central:
-					pad_central(str, needed, info.pad);
-				break;
-				default: // internal and right-justified
-					str.insert (0, needed, info.pad);
-			}
-		}
+	/**< Whether an argument of type Arg can be converted by c. */
+	template <typename Arg>
+	static constexpr bool accepts(CharT c) {
+		if (c == Tokens::universal)
+			return true;
+		if (c == Tokens::string)
+			return STD::is_convertible<Arg, CharT const*>{};
+		if (isFloatConversion(c))
+			return STD::is_floating_point<Arg>{};
+		return STD::is_integral<Arg>{};
 	}
 
-	template <bool needsSign, typename StringType>
-	static constexpr void pad_and_reverse ( STD::bool_constant<needsSign>, StringType& str, Info const& info )
+	/**< The state of compiling a format string. */
+	struct Compilation
 	{
-		if (needsSign && str.back() != Tokens::minus && info.prepend != '\0')
-			str += info.prepend;
+		STD::size_t pos = 0;
+		STD::size_t running = 0;
+		IndexConsistency consistency = IndexConsistency::NoCommitment;
+		bool valid = true;
+		bool consistent = true;
 
-		if (str.size() < (STD::size_t)info.width)
-		{
-			auto needed = info.width - str.size();
-			if (info.alignment & Info::right_justified)
-			{
-				auto pos = str.size();
-				if (info.alignment == Info::internal) {
-					if (str[pos-1]==Tokens::space
-					 || str[pos-1]==Tokens::plus
-					 || str[pos-1]==Tokens::minus)
-						--pos;
-					constexpr CharT hex[] {Tokens::lowerHex, Tokens::upperHex, '\0'};
-					if (str.find_last_of (hex, pos-2) != String::npos)
-						pos -= 2;
-				}
-				str.insert (pos, needed, info.pad);
-			}
-			// As the string is inverted at the moment, left justification means inserting padding on the left side
-			else if (info.alignment == Info::left_justified)
-				str.insert (0, needed, info.pad);
-			else /* central alignment */
-				pad_central(str,  needed, info.pad);
+		constexpr void commit(IndexConsistency c) {
+			if (consistency != IndexConsistency::NoCommitment && consistency != c)
+				consistent = false;
+			consistency = c;
 		}
+	};
 
-		Constainer::reverse (str.begin(), str.end() );
+	static constexpr STD::size_t parseNumber(CharT const* str, STD::size_t& pos) {
+		STD::size_t n = 0;
+		while (Tokens::is_dec_digit(str[pos]))
+			n = n*10 + (str[pos++] - Tokens::zero);
+		return n;
 	}
 
-	template <typename StringType, typename Real>
-	static constexpr StringType handleAbnormality ( Real r, bool upper ) {
-		StringType s;
-
-		if (r < STD::numeric_limits<Real>::lowest() ) {
-			s = Tokens::minus;
-			r = -r;
+	/**< Parses what follows a * in width or precision: either nothing, taking the next argument, or an index and $. */
+	static constexpr STD::size_t parseAsterisk(CharT const* str, Compilation& c) {
+		if (!Tokens::is_dec_digit(str[c.pos])) {
+			c.commit(IndexConsistency::Running);
+			return c.running++;
+		}
+		c.commit(IndexConsistency::NotRunning);
+		auto index = parseNumber(str, c.pos);
+		if (index == 0 || str[c.pos] != Tokens::dollar) {
+			c.valid = false;
+			return 0;
 		}
-		if (r > STD::numeric_limits<Real>::max() )
-			s += upper? Tokens::upperInf : Tokens::lowerInf;
-		else if (r != r)
-			s = upper? Tokens::upperNaN : Tokens::lowerNaN;
-		Constainer::reverse(s.begin(), s.end());
-		return s;
+		++c.pos;
+		return index-1;
 	}
 
-	template <typename StringType, typename Arg>
-	static constexpr auto printFloat (bool trimTrailingZeroes, Info const& info, Arg arg, bool* rounding_overflow=nullptr)
-	  -> require<STD::is_floating_point<Arg>, StringType>
-	{
-		auto str = handleAbnormality<StringType>(arg, info.upper);
-		if (not str.empty())
-			return str;
-
-		bool negative = is_negative(arg);
-		if (negative)
-			arg = -arg;
-
-		int precision = info.precision>=0? info.precision : 6;
-
-		if (precision != 0 or info.alternative)
-			str += Tokens::decimalPoint;
-		auto arg_tmp = fractional (arg);
-		auto digits = Tokens::get_digits (info.upper);
-
-		for (; precision > 1; --precision)
-		{
-			arg_tmp *= info.base;
-			STD::size_t rem = arg_tmp;
-			str += digits[rem];
-			arg_tmp -= rem;
+	/**< Parses the conversion specification following a %. */
+	static constexpr Segment parseSpec(CharT const* str, Compilation& c) {
+		Segment spec;
+
+		// An argument index, either n$ or n% as allowed by Boost.Format
+		auto start = c.pos;
+		auto index = parseNumber(str, c.pos);
+		if (c.pos != start && (str[c.pos] == Tokens::dollar || str[c.pos] == Tokens::percent)) {
+			c.commit(IndexConsistency::NotRunning);
+			c.valid = c.valid && index != 0;
+			spec.arg = index-1;
+			if (str[c.pos++] == Tokens::percent) {
+				spec.conversion = Tokens::universal;
+				return spec;
+			}
 		}
-		// Last digit is rounded
-		if (precision == 1)
-		{
-			arg_tmp *= info.base;
-			auto digit_index = rounded_remainder (arg_tmp, info.base);
-			if (digit_index == info.base)
-			{
-				digit_index = 0;
-				int pos = str.size();
-				while (--pos != 0)   // Until we reach the dot (which we know to have been written)
-				{
-					auto digit = Constainer::find (digits, digits+info.base, str[pos])-digits;
-					if (digit == info.base-1)
-						str[pos] = Tokens::zero;
-					else
-					{
-						str[pos] = digits[digit+1];
-						break;
-					}
-				}
-				if (pos == 0)
-				{
-					++arg;
-					if (arg >= info.base and rounding_overflow != nullptr)
-					{
-						arg = 1;
-						*rounding_overflow = true;
-					}
+		else
+			c.pos = start;
+
+		for (;; ++c.pos) {
+			auto flag = str[c.pos];
+			if (flag == Tokens::plus)
+				spec.prepend = Tokens::plus;
+			else if (flag == Tokens::space) {
+				if (spec.prepend != Tokens::plus)
+					spec.prepend = Tokens::space;
+			}
+			else if (flag == Tokens::minus) {
+				spec.alignment = Info::left_justified;
+				spec.pad = Tokens::space;
+			}
+			else if (flag == Tokens::alternative)
+				spec.alternative = true;
+			else if (flag == Tokens::internal_align)
+				spec.alignment = Info::internal;
+			else if (flag == Tokens::central_align)
+				spec.alignment = Info::central;
+			else if (flag == Tokens::zero) {
+				if (spec.alignment == Info::right_justified) {
+					spec.pad = Tokens::zero;
+					spec.alignment = Info::internal;
 				}
 			}
-			str += digits[digit_index];
+			else
+				break;
 		}
 
-		if (trimTrailingZeroes) {
-			str.erase(str.find_last_not_of(Tokens::zero)+1); // Remove trailing zeroes
-			if (str.back() == Tokens::decimalPoint and not info.alternative)
-				str.pop_back();
+		if (str[c.pos] == Tokens::asterisk) {
+			++c.pos;
+			spec.width_arg = parseAsterisk(str, c);
 		}
+		else
+			spec.width = parseNumber(str, c.pos);
 
-		Constainer::reverse (str.begin(), str.end() );
-		writeDigitsReversed (str, arg, info.base, digits);
-		if (negative)
-			str += '-';
-
-		return str;
-	}
-
-	template <typename StringType, typename Arg>
-	static constexpr StringType printExponential (bool trimTrailingZeroes, Info info, Arg arg, int exponent)
-	{
-		auto str = handleAbnormality<StringType>(arg, info.upper);
-		if (not str.empty())
-			return str;
-
-		constexpr CharT e_letter_arr[2][2] = {{Tokens::lowerExp , Tokens::upperExp},
-		                                      {Tokens::lowerHexp, Tokens::upperHexp}};
-		auto e_letter = e_letter_arr[info.base == 16][info.upper];
-
-		if (info.precision < 0)
-		{
-			if (info.base == 16)
-				// ::digits includes signbit, so +2 instead of +3
-				info.precision = (STD::numeric_limits<Arg>::digits + 2) / 4;
+		if (str[c.pos] == Tokens::decimalPoint) {
+			++c.pos;
+			if (str[c.pos] == Tokens::asterisk) {
+				++c.pos;
+				spec.precision_arg = parseAsterisk(str, c);
+			}
 			else
-				info.precision = 6;
+				spec.precision = parseNumber(str, c.pos);
 		}
 
-		bool negative = is_negative (arg);
-		if (negative)
-			arg = -arg;
-
-		auto digits = Tokens::get_digits (info.upper);
-
-		bool rounding_overflow = false;
-		auto mantissaString = printFloat<StringType>(trimTrailingZeroes, info, arg, &rounding_overflow);
-		if (rounding_overflow)
-			++exponent;
-		writeDigitsReversed (str, abs (exponent), 10, digits);
-
-		if (-info.base<exponent && exponent<info.base && info.base!=16)
-			str += Tokens::zero;
-		str += (exponent<0) ? Tokens::minus : Tokens::plus;
-		str += e_letter;
-		str += mantissaString;
-
-		if (info.base == 16)
-			str += info.upper? Tokens::upperHexPrefixReversed : Tokens::lowerHexPrefixReversed;
-
-		if (negative)
-			str += Tokens::minus;
-
-		return str;
-	}
+		spec.conversion = str[c.pos];
+		if (spec.conversion == '\0'
+		 || !(isFloatConversion(spec.conversion) || isIntegerConversion(spec.conversion)
+		   || spec.conversion == Tokens::string || spec.conversion == Tokens::universal))
+			c.valid = false;
+		else
+			++c.pos;
 
-	template <typename T>
-	static constexpr T log10_2 = 0.3010299956639811952137388947244L;
-	template <typename StringType, typename Arg>
-	static constexpr StringType printExponential (bool trimTrailingZeroes, Info const& info, Arg arg)
-	{
-		static_assert( STD::is_floating_point<Arg>{}, "Invalid argument for exponential FP-formatting!" );
-
-		auto norm = normalize (2, arg);
-		if (info.base == 10) {
-			auto exp = norm.second * log10_2<Arg>;
-			auto mant_exp = exp - int(exp);
-			auto mant = norm.first * pow10(mant_exp);
-			if (mant >= 10) {
-				mant /= 10;
-				++exp;
-			}
-			else if (mant < 1) {
-				mant *= 10;
-				--exp;
-			}
-			return printExponential<StringType> (trimTrailingZeroes, info, mant, exp);
+		if (spec.arg == none) {
+			c.commit(IndexConsistency::Running);
+			spec.arg = c.running++;
 		}
-		return printExponential<StringType> (trimTrailingZeroes, info, norm.first, norm.second);
+		return spec;
 	}
 
-	template <typename StringType, typename Arg>
-	static constexpr StringType printFloatHybrid (Info const& info, Arg arg)
-	{
-		static_assert( STD::is_floating_point<Arg>{}, "Invalid argument for hybrid FP-formatting!" );
-
-		auto str = handleAbnormality<StringType>(arg, info.upper);
-		if (not str.empty() )
-			return str;
-
-		auto data = normalize (info.base, arg);
-		Arg norm_arg = data.first;
-		int exp = data.second;
-		int precision = info.precision;
-
-		if (precision  < 0) precision = 6;
-		if (precision == 0) precision = 1;
-
-		auto info_adjusted = info;
-		info_adjusted.precision = precision - 1;
-		if (precision > exp && exp >= -4)
-		{
-			info_adjusted.precision -= exp;
-			str = printFloat<StringType>(not info.alternative, info_adjusted, arg);
-		}
-		else
-		{
-			str = Parser::printExponential<StringType>(not info.alternative, info_adjusted, norm_arg, exp);
-			//! str is still reversed!
-			if (not info.alternative)
-			{
-				auto last_pos = str.find_first_not_of ("0123456789+-")+1;
-				auto last_nonnull_pos = str.find_first_not_of (Tokens::zero, last_pos);
-				auto count = last_nonnull_pos-last_pos;
-				auto it = str.erase (last_pos, count);
-				if (str[last_nonnull_pos-count] == Tokens::decimalPoint)
-					str.erase (last_nonnull_pos-count, 1);
+	/**< Splits str into segments, of which the first N are stored. The last segment has no conversion. */
+	template <STD::size_t N>
+	static constexpr CompiledFormat<N> compile(CharT const* str) {
+		CompiledFormat<N> format;
+		Compilation c;
+		for (;;) {
+			auto literal = c.pos, end = literal;
+			while (str[end] != '\0' && str[end] != Tokens::percent)
+				++end;
+
+			Segment segment;
+			c.pos = end;
+			if (str[end] == Tokens::percent) {
+				++c.pos;
+				// %% ends a segment, which keeps the first %
+				if (str[c.pos] == Tokens::percent)
+					++c.pos, ++end;
+				else
+					segment = parseSpec(str, c);
 			}
+			segment.literal = literal;
+			segment.literal_length = end - literal;
+			if (format.size < N)
+				format.segments[format.size] = segment;
+			++format.size;
+
+			if (str[end] == '\0')
+				break;
 		}
-		return str;
+		format.valid = c.valid;
+		format.consistent = c.consistent;
+		return format;
 	}
 
-	template <typename StringType, typename Arg>
-	static constexpr StringType printInt (Info const& info, Arg arg)
+	/**< The padding of a field whose content has the given length. Internal padding follows the sign and base
+	     prefix of a number. */
+	struct Padding
 	{
-		static_assert( STD::is_integral<Arg>{}, "Invalid use of integer formatting!" );
-
-		// Default precision for integers is zero.
-		int precision = info.precision >= 0? info.precision : 1;
-
-		StringType str;
-		// If precision is zero and the argument is zero, conversion results in no characters
-		if (arg != Arg (0) )
-			writeDigitsReversed (str, arg, info.base, Tokens::get_digits(info.upper) );
-		if (str.size() < (STD::size_t)precision)
-			str.append (precision-str.size(), Tokens::zero);
-		// If the precision does not cause an additional 0 to be prepended, '#' does.
-		else if (info.base == 8 && info.alternative)
-			str += Tokens::zero;
-
-		// If we're writing hexadec, a 0X/0x is prepended to any nonzero argument if '#' is set
-		if (arg != 0 && info.alternative)
-			str += info.upper? Tokens::upperHexPrefixReversed : Tokens::lowerHexPrefixReversed;
-
-		if (arg < 0)
-			str += Tokens::minus;
-		return str;
+		STD::size_t before = 0, inside = 0, after = 0;
+	};
+	static constexpr Padding padding(Info const& info, STD::size_t length) {
+		Padding result;
+		if (length >= STD::size_t(info.width))
+			return result;
+		auto needed = info.width - length;
+		switch (info.alignment) {
+			case Info::left_justified:
+				result.after = needed;
+			break;
+			case Info::central:
+				result.before = (needed+1)/2;
+				result.after = needed/2;
+			break;
+			case Info::internal:
+				result.inside = needed;
+			break;
+			default:
+				result.before = needed;
+		}
+		return result;
 	}
 
-	template <typename StringType, typename P>
-	static constexpr StringType printString ( int precision, P s ) {
-		typename StringType::size_type len=0;
-		while (precision-- && *s)
-		{
-			++len;
-			++s;
-		}
-		return {s-len, len};
+	template <typename OutputIt>
+	static constexpr OutputIt writeString(OutputIt out, Info const& info, CharT const* s, STD::size_t length) {
+		auto pad = padding(info, length);
+		out = fillN(out, pad.before + pad.inside, info.pad);
+		out = putN(out, s, length);
+		return fillN(out, pad.after, info.pad);
 	}
 
-	template <CharT... ch>
-	struct parse;
+	template <typename OutputIt, typename Arg>
+	static constexpr OutputIt writeDigits(OutputIt out, Info const& info, Arg arg) {
+		// The digits in reverse order, enough for octal
+		Array<CharT, STD::numeric_limits<Arg>::digits/3 + 1> digits{};
+		STD::size_t count = 0;
+		auto magnitude = STD::make_unsigned_t<Arg>(arg);
+		if (is_negative(arg))
+			magnitude = 0 - magnitude;
+		auto symbols = Tokens::get_digits(info.upper);
+		for (; magnitude != 0; magnitude /= info.base)
+			digits[count++] = symbols[magnitude % info.base];
+
+		// Default precision for integers is one. If the precision does not cause a leading 0, '#' does for octal.
+		STD::size_t precision = info.precision >= 0? info.precision : 1,
+		            zeros = count < precision? precision - count : 0;
+		if (zeros == 0 && info.base == 8 && info.alternative)
+			zeros = 1;
+
+		CharT prefix[3] {};
+		STD::size_t prefix_length = 0;
+		if (is_negative(arg))
+			prefix[prefix_length++] = Tokens::minus;
+		else if (STD::is_signed<Arg>{} && info.prepend != '\0')
+			prefix[prefix_length++] = info.prepend;
+		if (info.base == 16 && info.alternative && arg != 0) {
+			prefix[prefix_length++] = Tokens::zero;
+			prefix[prefix_length++] = info.upper? Tokens::upperHex : Tokens::lowerHex;
+		}
+
+		auto pad = padding(info, prefix_length + zeros + count);
+		out = fillN(out, pad.before, info.pad);
+		out = putN(out, prefix, prefix_length);
+		out = fillN(out, pad.inside, info.pad);
+		out = fillN(out, zeros, Tokens::zero);
+		while (count != 0)
+			*out++ = digits[--count];
+		return fillN(out, pad.after, info.pad);
+	}
 
-	template <CharT... ch>
-	struct handleRest : Info
-	{
-		static constexpr bool indexLeap = 1;
+	template <typename OutputIt, typename Arg>
+	static constexpr OutputIt writeInteger(OutputIt out, Info info, CharT conversion, Arg arg) {
+		// Promote bool and character types, which make_signed does not apply to
+		using promoted = decltype(+arg);
+		if (conversion == Tokens::character) {
+			CharT c = arg;
+			return writeString(out, info, &c, 1);
+		}
+		// The 0 flag is ignored if a precision is given
+		if (info.precision >= 0 && info.pad == Tokens::zero) {
+			info.alignment = Info::right_justified;
+			info.pad = Tokens::space;
+		}
+		if (conversion == Tokens::universal)
+			return writeDigits(out, info, promoted(arg));
+		if (conversion == Tokens::decimalInt || conversion == Tokens::signedInt)
+			return writeDigits(out, info, STD::make_signed_t<promoted>(arg));
+		if (conversion == Tokens::octal)
+			info.base = 8;
+		else if (conversion != Tokens::unsignedInt) {
+			info.base = 16;
+			info.upper = conversion == Tokens::upperHex;
+		}
+		return writeDigits(out, info, STD::make_unsigned_t<promoted>(arg));
+	}
 
-		using type = parse<ch...>;
+	template <typename OutputIt, typename Arg>
+	static constexpr OutputIt writeFloatContent(OutputIt out, Info const& info, CharT conversion, Arg arg) {
+		if (arg != arg || arg > STD::numeric_limits<Arg>::max()) {
+			auto s = arg != arg? (info.upper? Tokens::upperNaN : Tokens::lowerNaN)
+			                   : (info.upper? Tokens::upperInf : Tokens::lowerInf);
+			return putN(out, s, Traits::length(s));
+		}
+		if (conversion == Tokens::lowerHexfloat || conversion == Tokens::upperHexfloat)
+			return formatHexadecimal<Tokens>(out, arg, info.precision, info.alternative, info.upper);
+
+		auto style = FloatStyle::general;
+		if (conversion == Tokens::lowerExp || conversion == Tokens::upperExp)
+			style = FloatStyle::scientific;
+		else if (conversion == Tokens::lowerFixed || conversion == Tokens::upperFixed)
+			style = FloatStyle::fixed;
+		// Without a precision, the shortest representation that converts back to arg
+		else if (conversion == Tokens::universal && info.precision < 0)
+			style = FloatStyle::shortest;
+		return formatDecimal<Tokens>(out, arg, style, info.precision >= 0? info.precision : 6,
+		                             info.alternative, info.upper);
+	}
 
-		template <typename NeedSign, typename StringType>
-		constexpr StringType pad_and_reverse (NeedSign b, StringType str) const {
-			Parser::pad_and_reverse (b, str, *this);
-			return str;
-		}
-		template <typename StringType>
-		constexpr StringType pad_unformatted (StringType str) const {
-			Parser::pad_unformatted (str, *this);
-			return str;
-		}
-	};
+	template <typename OutputIt, typename Arg>
+	static constexpr OutputIt writeFloat(OutputIt out, Info info, CharT conversion, Arg arg) {
+		info.upper = conversion == Tokens::upperExp    || conversion == Tokens::upperFixed
+		          || conversion == Tokens::upperHybrid || conversion == Tokens::upperHexfloat;
 
-	template <CharT... ch>
-	struct handleFormatSpecifier;
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::character, ch...> : handleRest<ch...> {
-		template <typename StringType>
-		constexpr void evaluate ( StringType& string, CharT c ) {
-			string += this->pad_and_reverse (STD::false_type {}, StringType{c} );
-		}
-	};
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::string, ch...> : handleRest<ch...> {
-		template <typename StringType>
-		constexpr void evaluate ( StringType& string, CharT const* s ) {
-			string += this->pad_unformatted (printString<StringType>(this->precision, s) );
-		}
-	};
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::signedInt, ch...> : handleFormatSpecifier<Tokens::decimalInt, ch...> {};
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::decimalInt, ch...> : handleFormatSpecifier<Tokens::universal, ch...> {
-		template <typename StringType, typename Arg>
-		constexpr void evaluate ( StringType& string, Arg arg ) {
-			static_assert( STD::is_integral<Arg>{}, "Invalid use of format specifier for (signed) integers!" );
-			handleFormatSpecifier<Tokens::universal, ch...>::evaluate(string, (STD::make_signed_t<Arg>)arg);
+		CharT prefix[3] {};
+		STD::size_t prefix_length = 0;
+		if (is_negative(arg)) {
+			prefix[prefix_length++] = Tokens::minus;
+			arg = -arg;
 		}
-	};
+		else if (info.prepend != '\0')
+			prefix[prefix_length++] = info.prepend;
 
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::unsignedInt, ch...> : handleFormatSpecifier<Tokens::universal, ch...> {
-		template <typename StringType, typename Arg>
-		constexpr void evaluate ( StringType& string, Arg arg ) {
-			static_assert( STD::is_integral<Arg>{}, "Invalid use of format specifier for (unsigned) integers!" );
-			handleFormatSpecifier<Tokens::universal, ch...>::evaluate(string, (STD::make_unsigned_t<Arg>)arg);
+		if (arg != arg || arg > STD::numeric_limits<Arg>::max()) {
+			// Infinity and NaN are not padded with zeroes
+			if (info.alignment == Info::internal)
+				info.alignment = Info::right_justified;
+			if (info.pad == Tokens::zero)
+				info.pad = Tokens::space;
 		}
-	};
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::upperExp, ch...> : handleFormatSpecifier<Tokens::lowerExp, ch...> {
-		template <typename StringType, typename Arg>
-		constexpr void evaluate ( StringType& string, Arg arg ) {
-			this->upper = true;
-			handleFormatSpecifier<Tokens::lowerExp, ch...>::evaluate (string, arg);
-		}
-	};
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::lowerExp, ch...> : handleRest<ch...> {
-		template <typename StringType, typename Arg>
-		constexpr void evaluate ( StringType& string, Arg arg ) {
-			// Hexfloat fractional trailing zeroes are trimmed (at least with libc++)
-			string += this->pad_and_reverse (STD::true_type {}, Parser::printExponential<StringType>(this->base==16, *this, arg) );
-		}
-	};
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::upperHybrid, ch...> : handleFormatSpecifier<Tokens::lowerHybrid, ch...> {
-		template <typename StringType, typename Arg>
-		constexpr void evaluate ( StringType& string, Arg const& arg ) {
-			this->upper = true;
-			return handleFormatSpecifier<Tokens::lowerHybrid, ch...>::evaluate (string, arg);
-		}
-	};
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::lowerHybrid, ch...> : handleRest<ch...> {
-		template <typename StringType, typename Arg>
-		constexpr void evaluate ( StringType& str, Arg arg ) {
-			str += this->pad_and_reverse (STD::true_type {}, printFloatHybrid<StringType>(*this, arg) );
-		}
-	};
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::upperFixed, ch...> : handleFormatSpecifier<Tokens::lowerFixed, ch...> {
-		template <typename StringType, typename Arg>
-		constexpr StringType evaluate ( Arg arg ) {
-			this->upper = true;
-			return handleFormatSpecifier<Tokens::lowerFixed, ch...>::evaluate (arg);
+		else if (conversion == Tokens::lowerHexfloat || conversion == Tokens::upperHexfloat) {
+			prefix[prefix_length++] = Tokens::zero;
+			prefix[prefix_length++] = info.upper? Tokens::upperHex : Tokens::lowerHex;
 		}
-	};
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::lowerFixed, ch...> : handleRest<ch...> {
-		template <typename StringType, typename Arg>
-		constexpr void evaluate ( StringType& string, Arg arg ) {
-			string += this->pad_and_reverse(STD::true_type{}, printFloat<StringType>(STD::false_type{}, *this, arg));
-		}
-	};
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::upperHexfloat, ch...> : handleFormatSpecifier<Tokens::lowerHexfloat, ch...> {
-		template <typename StringType, typename Arg>
-		constexpr void evaluate ( StringType& string, Arg arg ) {
-			this->upper = true;
-			return handleFormatSpecifier<Tokens::lowerHexfloat, ch...>::evaluate (string, arg);
-		}
-	};
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::lowerHexfloat, ch...> : handleFormatSpecifier<Tokens::lowerExp, ch...> {
-		template <typename StringType, typename Arg>
-		constexpr void evaluate ( StringType& string, Arg arg ) {
-			this->base = 16;
-			handleFormatSpecifier<Tokens::lowerExp, ch...>::evaluate(string, arg);
-		}
-	};
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::upperHex, ch...> : handleFormatSpecifier<ch...> {
-		template <typename StringType, typename Arg>
-		constexpr void evaluate ( StringType& string, Arg const& arg ) {
-			this->upper = true;
-			this->base = 16;
-			handleFormatSpecifier<ch...>::evaluate (string, arg);
-		}
-	};
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::lowerHex, ch...> : handleFormatSpecifier<Tokens::unsignedInt, ch...> {
-		template <typename StringType, typename Arg>
-		constexpr void evaluate ( StringType& string, Arg arg ) {
-			this->base = 16;
-			handleFormatSpecifier<Tokens::unsignedInt, ch...>::evaluate (string, arg);
-		}
-	};
-	/*template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::upperOctal, ch...> : handleFormatSpecifier<Tokens::octal, ch...> {
-		template <typename StringType, typename Arg>
-		constexpr void evaluate ( StringType& string, Arg const& arg ) {
-			this->upper = true;
-			handleFormatSpecifier<Tokens::octal, ch...>::evaluate (string, arg);
-		}
-	};*/
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::octal, ch...> : handleFormatSpecifier<Tokens::unsignedInt, ch...> {
-		template <typename StringType, typename Arg>
-		constexpr void evaluate ( StringType& string, Arg arg ) {
-			this->base = 8;
-			handleFormatSpecifier<Tokens::unsignedInt, ch...>::evaluate (string, arg);
-		}
-	};
-	/**< Generic format specifier */
-	template <CharT... ch>
-	struct handleFormatSpecifier<Tokens::universal, ch...> : handleRest<ch...>
-	{
-	private:
-		template <typename StringType>
-		struct buffer_t : STD::basic_streambuf<CharT>
-		{
-		private:
-			StringType _str;
-
-		public:
-			using typename STD::basic_streambuf<CharT>::int_type;
-
-			auto const& str() const {return _str;}
 
-		protected:
-			int_type overflow (int_type i) override {
-				if (Traits::eq_int_type (i, Traits::eof() ) )
-					return i;
-				_str += i;
-				return i;
-			}
-
-			STD::streamsize xsputn (CharT const* s, STD::streamsize count) override {
-				_str.append (s, count);
-				return count;
-			}
-		};
+		// The content is only measured if it might need padding.
+		STD::size_t length = prefix_length;
+		if (info.width > 0)
+			length += writeFloatContent(BoundedWriter<CharT>(nullptr, 0), info, conversion, arg).count();
 
-	public:
-
-		template <typename StringType>
-		constexpr void call ( detail::rank<1>, StringType& str, CharT const* s ) {
-			str += this->pad_unformatted (printString<StringType>(this->precision, s));
-		}
+		auto pad = padding(info, length);
+		out = fillN(out, pad.before, info.pad);
+		out = putN(out, prefix, prefix_length);
+		out = fillN(out, pad.inside, info.pad);
+		out = writeFloatContent(out, info, conversion, arg);
+		return fillN(out, pad.after, info.pad);
+	}
 
-		template <typename StringType>
-		constexpr void call ( detail::rank<1>, StringType& str, CharT c ) {
-			str += this->pad_and_reverse (STD::false_type {}, StringType{c});
-		}
+	template <typename OutputIt>
+	struct StreamBuffer : STD::basic_streambuf<CharT>
+	{
+		using typename STD::basic_streambuf<CharT>::int_type;
 
-		template <typename StringType, typename Arg>
-		constexpr auto call ( detail::rank<1>, StringType& str, Arg arg )
-		  -> require<STD::is_integral<Arg>>
-		{
-			str += this->pad_and_reverse (STD::is_signed<Arg>{}, printInt<StringType>(*this, arg) );
-		}
-		template <typename StringType, typename Arg>
-		constexpr auto call ( detail::rank<1>, StringType& str, Arg arg )
-		  -> require<STD::is_floating_point<Arg>>
-		{
-			str += this->pad_and_reverse (STD::true_type{}, printFloatHybrid<StringType>(*this, arg) );
-		}
-		template <typename StringType, typename Arg>
-		void call ( detail::rank<10>, StringType& str, Arg const& arg )
-		{
-			buffer_t<StringType> buf;
-			// Use standard library char_traits
-			STD::basic_ostream<CharT> stream (&buf);
-			applyInfoToStream(stream, *this);
-			stream << arg;
-			str += this->pad_unformatted( buf.str() );
-		}
+		OutputIt out;
 
-		template <typename StringType, typename Arg>
-		constexpr void evaluate ( StringType& str, Arg const& arg ) {
-			call (detail::rank<0> {}, str, arg);
-		}
-	};
+		explicit StreamBuffer(OutputIt o) : out(o) {}
 
-	template <typename, CharT... ch>
-	struct handlePrecisionDigits : handleFormatSpecifier<ch...>
-	{
-		template <typename StringType, typename Arg>
-		constexpr decltype (auto) evaluate ( StringType& string, Arg const& arg ) {
-			return handleFormatSpecifier<ch...>::evaluate (string, arg);
+	protected:
+		int_type overflow (int_type i) override {
+			if (!Traits::eq_int_type (i, Traits::eof() ) )
+				*out++ = Traits::to_char_type(i);
+			return i;
 		}
-	};
-	template <CharT c, CharT... ch>
-	struct handlePrecisionDigits<STD::enable_if_t<Tokens::is_dec_digit (c) >, c, ch...>
-		: handlePrecisionDigits<void, ch...>
-	{
-		template <typename StringType, typename Arg>
-		constexpr void evaluate ( StringType& string, Arg const& arg )
-		{
-			this->precision *= 10;
-			this->precision += c - Tokens::zero;
-			handlePrecisionDigits<void, ch...>::evaluate (string, arg);
-		}
-	};
 
-	/**< Primary template is not defined. If a decimal integer follows *, it must be part of an index terminating with $. */
-	template <STD::size_t, typename, CharT... ch>
-	struct handlePrecisionIndex;
-	template <STD::size_t precision_index, CharT c, CharT... ch>
-	struct handlePrecisionIndex<precision_index, STD::enable_if_t<Tokens::is_dec_digit(c)>, c, ch...>
-		: handlePrecisionIndex<precision_index*10 + c-Tokens::zero, void, ch...> {};
-	template <STD::size_t precision_index, CharT... ch>
-	struct handlePrecisionIndex<precision_index, void, Tokens::dollar, ch...>
-		: handleFormatSpecifier<ch...> {
-		template <STD::size_t index, typename StringType, typename ArgsTuple>
-		constexpr void evaluate ( StringType& string, ArgsTuple const& args ) {
-			this->precision = STD::get<precision_index-1>(args);
-			handleFormatSpecifier<ch...>::template evaluate (string, STD::get<index>(args));
+		STD::streamsize xsputn (CharT const* s, STD::streamsize count) override {
+			out = putN(out, s, count);
+			return count;
 		}
 	};
 
-	template <typename, CharT... ch>
-	struct handlePrecision : handleFormatSpecifier<ch...>
-	{
-		template <IndexConsistency, STD::size_t index, typename StringType, typename ArgsTuple>
-		constexpr void evaluate ( StringType& string, ArgsTuple const& args ) {
-			handleFormatSpecifier<ch...>::evaluate (string, STD::get<index>(args));
-		}
-	};
-	template <typename LessSpecialized, CharT... ch>
-	struct handlePrecision<LessSpecialized, Tokens::decimalPoint, Tokens::asterisk, ch...>  : handleFormatSpecifier<ch...>
+	template <typename OutputIt, typename Arg>
+	static constexpr auto writeArg ( rank<1>, OutputIt out, Info const& info, CharT, Arg const& s )
+	  -> require<STD::is_convertible<Arg const&, CharT const*>, OutputIt>
 	{
-		static constexpr auto indexLeap = handleFormatSpecifier<ch...>::indexLeap + 1;
-		template <IndexConsistency consistency, STD::size_t index, typename StringType, typename ArgsTuple>
-		constexpr void evaluate ( StringType& string, ArgsTuple const& args )
-		{
-			_assertRunning<consistency>();
-			this->precision = STD::get<index> (args);
-			handleFormatSpecifier<ch...>::evaluate (string, STD::get<index+1> (args) );
-		}
-	};
-	template <CharT c, CharT... ch>
-	struct handlePrecision<STD::enable_if_t<Tokens::is_dec_digit(c)>, Tokens::decimalPoint, Tokens::asterisk, c, ch...>
-		: handlePrecisionIndex<c-Tokens::zero, void, ch...>
+		STD::size_t length = 0;
+		while ((info.precision < 0 || length < STD::size_t(info.precision)) && s[length] != '\0')
+			++length;
+		return writeString(out, info, s, length);
+	}
+	template <typename OutputIt>
+	static constexpr OutputIt writeArg ( rank<1>, OutputIt out, Info const& info, CharT conversion, CharT c ) {
+		if (conversion == Tokens::universal)
+			return writeString(out, info, &c, 1);
+		return writeInteger(out, info, conversion, c);
+	}
+	template <typename OutputIt, typename Arg>
+	static constexpr auto writeArg ( rank<1>, OutputIt out, Info const& info, CharT conversion, Arg arg )
+	  -> require<STD::is_integral<Arg>, OutputIt>
 	{
-		template <IndexConsistency consistency, STD::size_t index, typename StringType, typename ArgsTuple>
-		constexpr void evaluate ( StringType& string, ArgsTuple const& args )
-		{
-			_assertNotRunning<consistency>();
-			this->precision = STD::get<index> (args);
-			handlePrecisionIndex<c-Tokens::zero, void, ch...>::template evaluate <index> (string, args);
-		}
-	};
-	template <typename LessSpecialized, CharT... ch>
-	struct handlePrecision<LessSpecialized, Tokens::decimalPoint, ch...> : handlePrecisionDigits<void, ch...>
+		return writeInteger(out, info, conversion, arg);
+	}
+	template <typename OutputIt, typename Arg>
+	static constexpr auto writeArg ( rank<1>, OutputIt out, Info const& info, CharT conversion, Arg arg )
+	  -> require<STD::is_floating_point<Arg>, OutputIt>
 	{
-		template <IndexConsistency, STD::size_t index, typename StringType, typename ArgsTuple>
-		constexpr void evaluate ( StringType& string, ArgsTuple const& args )
-		{
-			this->precision = 0;
-			handlePrecisionDigits<void, ch...>::template evaluate (string, STD::get<index>(args) );
-		}
-	};
-
-	template <typename, CharT... ch> struct handleWidth;
-
-	template <STD::size_t width_or_index, typename, CharT... ch>
-	struct handleWidthDigits : handlePrecision<void, ch...> {
-		template <IndexConsistency consistency, STD::size_t index, typename StringType, typename ArgsTuple>
-		constexpr void evaluate ( StringType& string, ArgsTuple const& args ) {
-			this->width = width_or_index;
-			handlePrecision<void, ch...>::template evaluate <consistency, index> (string, args);
-		}
-	};
-	template <STD::size_t width_or_index, CharT c, CharT... ch>
-	struct handleWidthDigits<width_or_index, STD::enable_if_t<Tokens::is_dec_digit (c) >, c, ch...>
-		: handleWidthDigits<width_or_index*10 + c-Tokens::zero, void, ch...> {};
-
-	/**< Primary template is not defined. If a decimal integer follows *, it must be part of an index terminating with $. */
-	template <STD::size_t, typename, CharT... ch>
-	struct handleWidthIndex;
-	template <STD::size_t width_index, CharT c, CharT... ch>
-	struct handleWidthIndex<width_index, STD::enable_if_t<Tokens::is_dec_digit(c)>, c, ch...>
-		: handleWidthIndex<width_index*10 + c-Tokens::zero, void, ch...> {};
-	template <STD::size_t width_index, CharT... ch>
-	struct handleWidthIndex<width_index, void, Tokens::dollar, ch...>
-		: handlePrecision<void, ch...> {
-		template <IndexConsistency consistency, STD::size_t index, typename StringType, typename ArgsTuple>
-		constexpr void evaluate ( StringType& string, ArgsTuple const& args ) {
-			_assertNotRunning<consistency>();
-			this->width = STD::get<width_index-1>(args);
-			handlePrecision<void, ch...>::template evaluate <IndexConsistency::NotRunning, index> (string, args);
-		}
-	};
-
-	template <typename, CharT... ch>
-	struct handleWidth : handlePrecision<void, ch...> {};
-	template <typename LessSpecialized, CharT... ch>
-	struct handleWidth<LessSpecialized, Tokens::asterisk, ch...> : handlePrecision<void, ch...>
+		return writeFloat(out, info, conversion, arg);
+	}
+	/**< Any other argument of the universal conversion is written by operator<<. */
+	template <typename OutputIt, typename Arg>
+	static OutputIt writeArg ( rank<10>, OutputIt out, Info const& info, CharT, Arg const& arg )
 	{
-		static constexpr auto indexLeap = handlePrecision<void, ch...>::indexLeap + 1;
-		template <IndexConsistency consistency, STD::size_t index, typename StringType, typename ArgsTuple>
-		constexpr void evaluate ( StringType& string, ArgsTuple const& args )
-		{
-			_assertRunning<consistency>();
-			this->width = STD::size_t (STD::get<index> (args) );
-			// negative width results in '-' being set and the corresponding positive width
-			if (this->width < 0)
-			{
-				this->alignment = Info::left_justified;
-				this->width = -this->width;
-			}
-			handlePrecision<void, ch...>::template evaluate <IndexConsistency::Running, index+1> (string, args);
-		}
-	};
-	template <CharT c, CharT... ch>
-	struct handleWidth<STD::enable_if_t<Tokens::is_dec_digit(c)>, Tokens::asterisk, c, ch...>
-		: handleWidthIndex<c-Tokens::zero, void, ch...> {};
-	template <CharT c, CharT... ch>
-	struct handleWidth<STD::enable_if_t<Tokens::is_dec_digit(c)>, c, ch...>
-		: handleWidthDigits<c-Tokens::zero, void, ch...> {};
-
-	template <CharT... ch>
-	struct handleFlags : handleWidth<void, ch...> {};
-
-#define CONSTAINER_HANDLE_WIDTH_SPEC(c, ...)                                 \
-	template <CharT... ch>                                                   \
-	struct handleFlags<c, ch...> : handleFlags<ch...> {                      \
-		template <IndexConsistency C, STD::size_t I, typename S, typename A> \
-		constexpr void evaluate( S& s, A const& args ) {                     \
-			__VA_ARGS__                                                      \
-			handleFlags<ch...>::template evaluate<C, I>(s, args);            \
-		}                                                                    \
-	};
-
-	CONSTAINER_HANDLE_WIDTH_SPEC (Tokens::plus, this->prepend = Tokens::plus;)
-	CONSTAINER_HANDLE_WIDTH_SPEC (Tokens::space, if (this->prepend != Tokens::plus)
-	                                                 this->prepend = Tokens::space;)
-	CONSTAINER_HANDLE_WIDTH_SPEC (Tokens::minus, this->alignment = Info::left_justified; this->pad = Tokens::space;)
-	CONSTAINER_HANDLE_WIDTH_SPEC (Tokens::alternative, this->alternative = true;)
-	CONSTAINER_HANDLE_WIDTH_SPEC (Tokens::internal_align, this->alignment = Info::internal;)
-	CONSTAINER_HANDLE_WIDTH_SPEC (Tokens::central_align, this->alignment = Info::central;)
-	CONSTAINER_HANDLE_WIDTH_SPEC (Tokens::zero, if (this->alignment == Info::right_justified) {
-	                                                this->pad = Tokens::zero;
-	                                                this->alignment = Info::internal;})
-
-#undef CONSTAINER_HANDLE_WIDTH_SPEC
-
-	template <CharT... ch>
-	struct genIndexInfo {
-	private:
-		struct indexInfo {
-			STD::size_t index=0;
-			STD::size_t read=1; // For the terminating char
-			bool isPercentSignTerm=false;
-		};
-		static constexpr indexInfo isIndex(CharT const* str) {
-			indexInfo info;
-
-			for (; Tokens::is_dec_digit(*str); ++str) {
-				info.index *= 10; info.index += *str - Tokens::zero;
-				++info.read;
-			}
-
-			if (*str == Tokens::percent)
-				info.isPercentSignTerm = true;
-			else if (*str != Tokens::dollar)
-				info.read = 0;
-
-			return info;
-		}
-
-	public:
-		static constexpr CharT str[] {ch...};
-		static constexpr indexInfo info = isIndex(str);
-	};
-
-	/**< The bool parameter is true if we have a format specifier a la %2%, as e.g. allowed by Boost.Format. */
-	template <bool isPercentTerminated, typename Arr, typename=STD::make_index_sequence<sizeof(Arr::str)-Arr::info.read>>
-	struct handleArgIndex;
-	template <typename Arr, STD::size_t... indices>
-	struct handleArgIndex<false, Arr, STD::index_sequence<indices...>>
-		: handleFlags<Arr::str[Arr::info.read + indices]...> {
-		template <IndexConsistency C, STD::size_t I, typename StringType, typename ArgsTuple>
-		constexpr void evaluate( StringType& string, ArgsTuple const& args ) {
-			_assertNotRunning<C>();
-			handleFlags<Arr::str[Arr::info.read + indices]...>::template evaluate<IndexConsistency::NotRunning, Arr::info.index-1>(string, args);
-		}
-	};
-	template <typename Arr, STD::size_t... indices>
-	struct handleArgIndex<true, Arr, STD::index_sequence<indices...>>
-		: handleFormatSpecifier<Tokens::universal> {
-
-		template <IndexConsistency C, STD::size_t, typename StringType, typename ArgsTuple>
-		constexpr void evaluate( StringType& string, ArgsTuple const& args ) {
-			_assertNotRunning<C>();
-			handleFormatSpecifier<Tokens::universal>::evaluate(string, STD::get<Arr::info.index-1>(args) );
-		}
-	};
+		StreamBuffer<OutputIt> buf(out);
+		// Use standard library char_traits
+		STD::basic_ostream<CharT> stream (&buf);
+		applyInfoToStream(stream, info);
+		stream << arg;
+		return buf.out;
+	}
 
-	template <typename, CharT... ch>
-	struct handleArgIndexOpt : handleFlags<ch...> {
-		template <IndexConsistency C, STD::size_t I, typename StringType, typename ArgsTuple>
-		constexpr void evaluate( StringType& string, ArgsTuple const& args ) {
-			_assertRunning<C>();
-			handleFlags<ch...>::template evaluate<IndexConsistency::Running, I>(string, args);
-		}
-	};
-	template <CharT... ch>
-	struct handleArgIndexOpt<STD::enable_if_t<genIndexInfo<ch...>::info.read != 0>, ch...>
-		: handleArgIndex<genIndexInfo<ch...>::info.isPercentSignTerm, genIndexInfo<ch...>> {};
+	template <STD::size_t I, typename ArgsTuple>
+	static constexpr int intArg(ArgsTuple const& args, STD::true_type) {return STD::get<I>(args);}
+	template <STD::size_t, typename ArgsTuple>
+	static constexpr int intArg(ArgsTuple const&, STD::false_type) {return 0;}
 
 	template <CharT... ch>
 	struct parse
@@ -876,48 +631,88 @@ struct Parser {
 		template <CharT...>
 		friend struct parse;
 
-		template <typename P>
-		static constexpr P findFirstFormatSpec ( P str )
-		{
-			while (*str && (*str != Tokens::percent || *++str == Tokens::percent) )
-				++str;
-			return str;
-		}
-
 		static constexpr CharT str[] {ch..., '\0'};
-		static constexpr auto formatSpecPos = findFirstFormatSpec(str)-str;
-		static_assert (formatSpecPos < sizeof str);
+		static constexpr auto segments = compile<1>(str).size;
+		static constexpr CompiledFormat<segments> format = compile<segments>(str);
 
-		template <IndexConsistency, STD::size_t, typename StringType, typename ArgsTuple>
-		constexpr void call ( StringType& string, STD::index_sequence<>, ArgsTuple const&) {
-			string.append(str, sizeof(str)-1);
-		}
+		static_assert( format.valid, "Invalid format string!" );
+		static_assert( format.consistent, "Can't interchangeably use running and specified indices!" );
 
-		template <IndexConsistency consistency, STD::size_t index, STD::size_t... indices, typename StringType, typename ArgsTuple>
-		constexpr void call ( StringType& string, STD::index_sequence<indices...>, ArgsTuple const& args )
+		template <STD::size_t k, typename OutputIt, typename ArgsTuple>
+		static constexpr OutputIt convert( OutputIt out, ArgsTuple const&, STD::false_type ) {
+			return out;
+		}
+		template <STD::size_t k, typename OutputIt, typename ArgsTuple>
+		static constexpr OutputIt convert( OutputIt out, ArgsTuple const& args, STD::true_type )
 		{
-			string.append(str, formatSpecPos-1);
-			using handle_type = handleArgIndexOpt<void, str[formatSpecPos+indices]...>;
-			using next_parser_type = typename handle_type::type;
-			handle_type {} .template evaluate <consistency, index> (string, args);
-			next_parser_type {}.template call<consistency, index + handle_type::indexLeap>(string, args);
+			constexpr Segment segment = format.segments[k];
+			using arg_type = STD::decay_t<STD::tuple_element_t<segment.arg, ArgsTuple>>;
+			static_assert( accepts<arg_type>(segment.conversion), "Invalid argument for format specifier!" );
+
+			Info info = segment;
+			if (segment.width_arg != none) {
+				info.width = intArg<segment.width_arg>(args, STD::integral_constant<bool, segment.width_arg != none>{});
+				// A negative width is taken as the - flag
+				if (info.width < 0) {
+					info.alignment = Info::left_justified;
+					info.pad = Tokens::space;
+					info.width = -info.width;
+				}
+			}
+			// A negative precision is taken as if it were omitted
+			if (segment.precision_arg != none)
+				info.precision = STD::max(-1, intArg<segment.precision_arg>(args,
+				                                  STD::integral_constant<bool, segment.precision_arg != none>{}));
+			return writeArg(rank<0>{}, out, info, segment.conversion, STD::get<segment.arg>(args));
 		}
 
-		template <IndexConsistency C, STD::size_t I, typename StringType, typename ArgsTuple>
-		constexpr void call (StringType& string, ArgsTuple const& args) {
-			call<C, I>(string, STD::make_index_sequence<sizeof(str)-1-formatSpecPos> {}, args);
+		template <typename OutputIt, typename ArgsTuple>
+		static constexpr OutputIt write( OutputIt out, ArgsTuple const&, STD::integral_constant<STD::size_t, segments> ) {
+			return out;
+		}
+		template <STD::size_t k, typename OutputIt, typename ArgsTuple>
+		static constexpr OutputIt write( OutputIt out, ArgsTuple const& args, STD::integral_constant<STD::size_t, k> )
+		{
+			constexpr Segment segment = format.segments[k];
+			out = putN(out, str + segment.literal, segment.literal_length);
+			out = convert<k>(out, args, STD::integral_constant<bool, segment.conversion != '\0'>{});
+			return write(out, args, STD::integral_constant<STD::size_t, k+1>{});
 		}
 
 	public:
+		/**< Writes the formatted arguments to out and returns the iterator past the output. */
+		template <typename OutputIt, typename... Args>
+		constexpr OutputIt format_to( OutputIt out, Args const&... args ) const {
+			return write(out, STD::forward_as_tuple(args...), STD::integral_constant<STD::size_t, 0>{});
+		}
+		/**< Writes at most n characters to buf and returns the length of the entire output, like snprintf,
+		     but without a terminating null character. */
+		template <typename... Args>
+		constexpr STD::size_t format_to_n( CharT* buf, STD::size_t n, Args const&... args ) const {
+			return format_to(BoundedWriter<CharT>(buf, n), args...).count();
+		}
+		/**< The number of characters written by format_to. */
+		template <typename... Args>
+		constexpr STD::size_t formatted_size( Args const&... args ) const {
+			return format_to_n(nullptr, 0, args...);
+		}
+		/**< Appends the output to str, which needs push_back and append, e.g. any BasicString. */
+		template <typename StringType, typename... Args>
+		constexpr StringType& append_to( StringType& str, Args const&... args ) const {
+			format_to(StringAppender<StringType>(str), args...);
+			return str;
+		}
+
 		template <typename StringType, typename... Args>
-		constexpr StringType evaluate( Args&& ... args ) {
+		constexpr StringType evaluate( Args const&... args ) const {
 			StringType s;
-			call<IndexConsistency::NoCommitment, 0>( s, STD::forward_as_tuple(STD::forward<Args>(args)...) );
+			append_to(s, args...);
 			return s;
 		}
+		/**< Formats into a BasicString<CharT, 256>; longer output requires one of the above. */
 		template <typename... Args>
-		constexpr auto operator()( Args&& ... args ) {
-			return evaluate<BasicString<CharT, 256>>(STD::forward<Args>(args)...);
+		constexpr auto operator()( Args const&... args ) const {
+			return evaluate<BasicString<CharT, 256>>(args...);
 		}
 	};
 
@@ -926,6 +721,10 @@ struct Parser {
 template <typename CharT, typename Tokens, typename Traits>
 template <CharT... c>
 constexpr CharT Parser<CharT, Tokens, Traits>::parse<c...>::str[];
+template <typename CharT, typename Tokens, typename Traits>
+template <CharT... c>
+constexpr typename Parser<CharT, Tokens, Traits>::template CompiledFormat<Parser<CharT, Tokens, Traits>::template parse<c...>::segments>
+	Parser<CharT, Tokens, Traits>::parse<c...>::format;
 
 } // end namespace detail
 
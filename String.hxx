@@ -6,6 +6,7 @@
 #pragma once
 
 #include "impl/BasicVector.hxx"
+#include "StringSearch.hxx"
 
 #include <string> // char_traits
 
@@ -460,10 +461,10 @@ public:
 		return traits_type::copy(dest, data()+pos, STD::min(count, size()-pos)) - dest;
 	}
 
-	void resize(size_type n) {_base::resize(n);}
-	void resize(size_type n, value_type c) {_base::resize(n, c);}
+	constexpr void resize(size_type n) {_base::resize(n);}
+	constexpr void resize(size_type n, value_type c) {_base::resize(n, c);}
 
-	void push_back(value_type c) {_base::push_back(c);}
+	constexpr void push_back(value_type c) {_base::push_back(c);}
 
 	template <STD::size_t OtherMax, typename OtherTraits>
 	constexpr void swap( BasicString<value_type, OtherMax, OtherTraits>& other ) {
@@ -472,22 +473,28 @@ public:
 
 	/**< --------- @FIND ---------*/
 
-	//! TODO: Implement Boyer-Moore.
 	constexpr size_type find(const_pointer str, size_type pos, size_type count) const {
-		if (pos < size()) {
-			auto it = Constainer::search(begin()+pos, end(), str, str+count,
-			                             traits_type::eq);
-			if (it != end())
-				return it-begin();
+		if (pos > size() || count > size()-pos)
+			return npos;
+		if (count == 0)
+			return pos;
+		if (count == 1)
+			return find(*str, pos);
+		// A Searcher costs about as much to prepare as 256 comparisons. The naive search is cheaper if its worst case
+		// is below that, and stays linear for two characters.
+		auto n = size()-pos;
+		if (count == 2 || (n-count+1) * count <= 256) {
+			auto p = detail::findNaive<Traits>(data()+pos, n, str, count);
+			return p? p-data() : npos;
 		}
-		return npos;
+		return find(Searcher<Char, Traits>(str, str+count), pos);
 	}
 	constexpr size_type find(const_pointer str, size_type pos=0) const {
 		return find(str, pos, traits_type::length(str));
 	}
 	constexpr size_type find(value_type ch, size_type pos=0) const {
 		if (pos < size())
-			if (auto p = traits_type::find(data()+pos, size()-pos, ch))
+			if (auto p = detail::findChar<Traits>(data()+pos, size()-pos, ch))
 				return p-data();
 
 		return npos;
@@ -496,41 +503,73 @@ public:
 	constexpr size_type find(ThisResized<OtherMax> const& other, size_type pos = 0) const {
 		return find(other.data(), pos, other.size());
 	}
+	/**< Searches with a prepared searcher, e.g. for a pattern that is looked for in many strings. */
+	constexpr size_type find(Searcher<Char, Traits> const& searcher, size_type pos = 0) const {
+		if (pos > size())
+			return npos;
+		auto p = searcher.search(data()+pos, data()+size());
+		if (p == data()+size() && searcher.pattern_length() != 0)
+			return npos;
+		return p-data();
+	}
 
 	/**< --------- @RFIND ---------*/
 
 	constexpr size_type rfind(const_pointer str, size_type pos, size_type count) const {
 		if (count == 0)
 			return STD::min(size(), pos);
-		if (!empty()) {
-			pos = STD::min(pos, size()-1);
-			auto it = Constainer::search(rbegin()+(size()-pos-1), rend(),
-			                             Constainer::make_reverse_iterator(str+count),
-			                             Constainer::make_reverse_iterator(str),
-			                             traits_type::eq);
-			if (it != rend())
-				return it.base()-begin()-count;
-		}
-		return npos;
+		if (count == 1)
+			return rfind(*str, pos);
+		// pos is the last position the occurrence may cover.
+		if (empty() || STD::min(pos, size()-1) + 1 < count)
+			return npos;
+
+		// Search the reversed pattern in the reversed prefix [0, pos].
+		using reverse_pointer = Constainer::reverse_iterator<const_pointer>;
+		auto first = reverse_pointer(data()+STD::min(pos, size()-1)+1), last = reverse_pointer(data());
+		auto it = BasicSearcher<reverse_pointer, Traits>(reverse_pointer(str+count), reverse_pointer(str)).search(first, last);
+		if (it == last)
+			return npos;
+		return it.base()-data()-count;
 	}
 	constexpr size_type rfind(const_pointer str, size_type pos=npos) const {
 		return rfind(str, pos, traits_type::length(str));
 	}
 	constexpr size_type rfind(value_type ch, size_type pos=npos) const {
-		return rfind(&ch, pos, 1);
+		if (!empty())
+			for (auto i = STD::min(pos, size()-1)+1; i-- != 0;)
+				if (traits_type::eq(data()[i], ch))
+					return i;
+		return npos;
 	}
 	template <STD::size_t OtherMax>
 	constexpr size_type rfind(ThisResized<OtherMax> const& other, size_type pos = npos) const {
 		return rfind(other.data(), pos, other.size());
 	}
 
+private:
+	constexpr size_type _find_first(CharSet<Char, Traits> const& set, size_type pos, bool member) const {
+		for (; pos < size(); ++pos)
+			if (set.contains(data()[pos]) == member)
+				return pos;
+		return npos;
+	}
+	constexpr size_type _find_last(CharSet<Char, Traits> const& set, size_type pos, bool member) const {
+		if (!empty())
+			for (auto i = STD::min(pos, size()-1)+1; i-- != 0;)
+				if (set.contains(data()[i]) == member)
+					return i;
+		return npos;
+	}
+
+public:
+
 	/**< --------- @FIND_FIRST_OF ---------*/
 
 	constexpr size_type find_first_of(const_pointer str, size_type pos, size_type count) const {
-		auto it = Constainer::find_first_of(begin()+pos, end(), str, str+count, traits_type::eq);
-		if (it == end())
-			return npos;
-		return it-begin();
+		if (count == 1)
+			return find(*str, pos);
+		return _find_first({str, count}, pos, true);
 	}
 	constexpr size_type find_first_of(const_pointer str, size_type pos=0) const {
 		return find_first_of(str, pos, traits_type::length(str));
@@ -546,17 +585,16 @@ public:
 	/**< --------- @FIND_FIRST_NOT_OF ---------*/
 
 	constexpr size_type find_first_not_of(const_pointer str, size_type pos, size_type count) const {
-		auto it = Constainer::find_first_not_of(begin()+pos, end(), str, str+count, traits_type::eq);
-		if (it == end())
-			return npos;
-		return it-begin();
+		return _find_first({str, count}, pos, false);
 	}
 	constexpr size_type find_first_not_of(const_pointer str, size_type pos=0) const {
 		return find_first_not_of(str, pos, traits_type::length(str));
 	}
 	constexpr size_type find_first_not_of(value_type ch, size_type pos=0) const {
-		//! TODO: Implement STD::not1 and implement using find_if with not1(traits::eq)
-		return find_first_not_of(&ch, pos, 1);
+		for (; pos < size(); ++pos)
+			if (!traits_type::eq(data()[pos], ch))
+				return pos;
+		return npos;
 	}
 	template <STD::size_t OtherMax>
 	constexpr size_type find_first_not_of(ThisResized<OtherMax> const& other, size_type pos = 0) const {
@@ -566,11 +604,7 @@ public:
 	/**< --------- @FIND_LAST_OF ---------*/
 
 	constexpr size_type find_last_of(const_pointer str, size_type pos, size_type count) const {
-		pos = STD::min(pos, size()-1);
-		auto it = Constainer::find_first_of(rbegin()+(size()-pos-1), rend(), str, str+count, traits_type::eq);
-		if (it.base() == begin())
-			return npos;
-		return it.base()-1-begin();
+		return _find_last({str, count}, pos, true);
 	}
 	constexpr size_type find_last_of(const_pointer str, size_type pos=npos) const {
 		return find_last_of(str, pos, traits_type::length(str));
@@ -586,21 +620,21 @@ public:
 	/**< --------- @FIND_LAST_NOT_OF ---------*/
 
 	constexpr size_type find_last_not_of(const_pointer str, size_type pos, size_type count) const {
-		pos = STD::min(pos, size()-1);
-		auto it = Constainer::find_first_not_of(rbegin()+(size()-pos-1), rend(), str, str+count, traits_type::eq);
-		if (it.base() == begin())
-			return npos;
-		return it.base()-1-begin();
+		return _find_last({str, count}, pos, false);
 	}
 	constexpr size_type find_last_not_of(const_pointer str, size_type pos=npos) const {
 		return find_last_not_of(str, pos, traits_type::length(str));
 	}
 	constexpr size_type find_last_not_of(value_type ch, size_type pos=npos) const {
-		return find_last_not_of(&ch, pos, 1);
+		if (!empty())
+			for (auto i = STD::min(pos, size()-1)+1; i-- != 0;)
+				if (!traits_type::eq(data()[i], ch))
+					return i;
+		return npos;
 	}
 	template <STD::size_t OtherMax>
 	constexpr size_type find_last_not_of(ThisResized<OtherMax> const& other, size_type pos = npos) const {
-		return find_last_of(other.data(), pos, other.size());
+		return find_last_not_of(other.data(), pos, other.size());
 	}
 };
 
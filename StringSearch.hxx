@@ -0,0 +1,251 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+#include "Array.hxx"
+
+#include <cstdint>
+#include <string> // char_traits
+
+namespace Constainer {
+
+template <typename Char>
+struct CharTraits;
+
+namespace detail {
+	/**< Whether Traits compares characters by their value, so that the C library and lookup tables keyed by
+	     (parts of) the value can stand in for Traits::eq. */
+	template <typename Char, typename Traits>
+	using hasIdentityEq = STD::integral_constant<bool, STD::is_same<Traits, CharTraits<Char>>{}
+	                                                || STD::is_same<Traits, STD::char_traits<Char>>{}>;
+
+	template <typename Char>
+	CONSTAINER_PURE_CONST constexpr STD::uint8_t lowByte(Char c) {
+		return static_cast<STD::uint8_t>(c);
+	}
+
+	/**< Traits::find, except that at runtime, STD::char_traits (i.e. memchr or wmemchr) is used where equivalent. */
+	template <typename Traits, typename Char>
+	constexpr Char const* findChar(Char const* s, STD::size_t n, Char const& ch) {
+		if (hasIdentityEq<Char, Traits>{} && !isConstantEvaluated())
+			return STD::char_traits<Char>::find(s, n, ch);
+		return Traits::find(s, n, ch);
+	}
+
+	/**< Finds the first occurrence of [p, p+m) in [s, s+n) by comparing the pattern at every occurrence of its first
+	     character. Needs no preprocessing, but up to (n-m+1)*m comparisons. Requires 0 < m <= n. */
+	template <typename Traits, typename Char>
+	constexpr Char const* findNaive(Char const* s, STD::size_t n, Char const* p, STD::size_t m) {
+		auto last = s + (n-m) + 1;
+		while (auto first = findChar<Traits>(s, last-s, *p)) {
+			if (Traits::compare(first+1, p+1, m-1) == 0)
+				return first;
+			s = first+1;
+		}
+		return nullptr;
+	}
+}
+
+/**< A set of characters with constant-time membership tests, used by the find_first_of family.
+     A bitmap indexed by the low byte of a character is exact for single-byte characters. For wider characters,
+     it rules out most non-members before the characters are searched. Traits whose eq is not value equality
+     always search. The characters are not copied; they must outlive the set. */
+template <typename Char, typename Traits = CharTraits<Char>>
+class CharSet {
+	static constexpr bool _filtered = detail::hasIdentityEq<Char, Traits>{};
+	static constexpr bool _exact = _filtered && sizeof(Char) == 1;
+
+	Array<STD::uint64_t, 4> _bits{};
+	Char const* _chars;
+	STD::size_t _count;
+
+	constexpr bool _test(STD::uint8_t b) const {return _bits[b/64] >> b%64 & 1;}
+
+public:
+	constexpr CharSet(Char const* s, STD::size_t count) : _chars(s), _count(count) {
+		while (count--) {
+			auto b = detail::lowByte(*s++);
+			_bits[b/64] |= STD::uint64_t(1) << b%64;
+		}
+	}
+
+	constexpr bool contains(Char c) const {
+		if (_exact)
+			return _test(detail::lowByte(c));
+		if (_filtered && !_test(detail::lowByte(c)))
+			return false;
+		return Traits::find(_chars, _count, c) != nullptr;
+	}
+	constexpr bool operator()(Char c) const {return contains(c);}
+};
+
+/**< Searches for a fixed pattern with the Two-Way algorithm of Crochemore and Perrin, which needs O(n+m) comparisons
+     and constant space. The pattern is split at a critical factorization; each window is matched from that split
+     to the right first, and a mismatch on the right half allows a shift proportional to the matched length. For
+     periodic patterns, the matched prefix is remembered to keep the total work linear.
+
+     Before matching a window, the last character of the window is looked up in a Horspool table to skip windows
+     quickly. At runtime, the next plausible window is found with STD::char_traits<>::find (memchr), which the
+     C library vectorizes. All preprocessing is done on construction, so a Searcher can be reused on any number of
+     haystacks. Like the standard searchers, the pattern is not copied. */
+template <typename PatternIt,
+          typename Traits = CharTraits<STD::remove_cv_t<typename STD::iterator_traits<PatternIt>::value_type>>>
+class BasicSearcher {
+public:
+	using size_type   = STD::size_t;
+	using traits_type = Traits;
+	using char_type   = typename Traits::char_type;
+
+private:
+	static constexpr size_type _npos = -1;
+	static constexpr bool _use_table = detail::hasIdentityEq<char_type, Traits>{};
+
+	PatternIt _pattern;
+	size_type _length;
+	// Start of the right half of the critical factorization
+	size_type _suffix = 0;
+	// Shift after a complete match
+	size_type _period = 1;
+	bool _periodic = false;
+	// Horspool shifts, indexed by low byte, of the last character of a window
+	Array<size_type, 256> _shift{};
+
+	/**< Computes the maximal suffix of the pattern with respect to the order given by less, or its reverse.
+	     Returns its starting position minus one (mod 2^N) and sets period to the period of that suffix. */
+	constexpr size_type _maximal_suffix(bool reversed, size_type& period) const {
+		size_type max_suffix = _npos, j = 0, k = 1, p = 1;
+		while (j + k < _length) {
+			char_type a = _pattern[j + k], b = _pattern[max_suffix + k];
+			if (reversed? Traits::lt(b, a) : Traits::lt(a, b)) {
+				j += k;
+				k = 1;
+				p = j - max_suffix;
+			}
+			else if (Traits::eq(a, b)) {
+				if (k != p)
+					++k;
+				else {
+					j += p;
+					k = 1;
+				}
+			}
+			else {
+				max_suffix = j++;
+				k = p = 1;
+			}
+		}
+		period = p;
+		return max_suffix;
+	}
+
+	template <typename RandomIt>
+	static constexpr bool _vectorizable() {
+		return _use_table && STD::is_pointer<RandomIt>{}
+		    && STD::is_same<STD::remove_cv_t<STD::remove_pointer_t<RandomIt>>, char_type>{};
+	}
+
+	/**< Returns the start of the next window that may match, given that the window at j cannot. */
+	template <typename RandomIt>
+	constexpr size_type _next_window(RandomIt first, size_type j, size_type n, size_type shift) const {
+		if (_vectorizable<RandomIt>() && !isConstantEvaluated()) {
+			auto next = &first[j + _length];
+			if (auto p = STD::char_traits<char_type>::find(next, n - j - _length, _pattern[_length-1]))
+				return p - &first[0] - (_length-1);
+			return n;
+		}
+		return j + shift;
+	}
+
+public:
+
+	constexpr BasicSearcher(PatternIt first, PatternIt last) : _pattern(first), _length(last - first) {
+		if (_length == 0)
+			return;
+
+		size_type period = 1, rev_period = 1;
+		auto max_suffix = _maximal_suffix(false, period),
+		     rev_max_suffix = _maximal_suffix(true, rev_period);
+		if (rev_max_suffix + 1 < max_suffix + 1) {
+			_suffix = max_suffix + 1;
+			_period = period;
+		}
+		else {
+			_suffix = rev_max_suffix + 1;
+			_period = rev_period;
+		}
+
+		_periodic = _suffix + _period <= _length
+		         && Constainer::equal(_pattern, _pattern + _suffix, _pattern + _period, Traits::eq);
+		if (!_periodic)
+			_period = STD::max(_suffix, _length - _suffix) + 1;
+
+		if (_use_table) {
+			Constainer::fill(_shift.begin(), _shift.end(), _length);
+			for (size_type i = 0; i != _length-1; ++i)
+				_shift[detail::lowByte(_pattern[i])] = _length-1 - i;
+			_shift[detail::lowByte(_pattern[_length-1])] = 0;
+		}
+	}
+
+	constexpr size_type pattern_length() const {return _length;}
+
+	/**< Returns an iterator to the first occurrence of the pattern in [first, last), or last. */
+	template <typename RandomIt>
+	constexpr RandomIt search(RandomIt first, RandomIt last) const {
+		size_type n = last - first;
+		if (_length == 0)
+			return first;
+		if (n < _length)
+			return last;
+
+		size_type j = 0, memory = 0;
+		while (j <= n - _length) {
+			if (auto shift = _shift[detail::lowByte(first[j + _length-1])]) {
+				j = _next_window(first, j, n, shift);
+				memory = 0;
+				continue;
+			}
+
+			auto i = STD::max(_suffix, memory);
+			while (i < _length && Traits::eq(_pattern[i], first[i + j]))
+				++i;
+			if (i < _length) {
+				j += i - _suffix + 1;
+				memory = 0;
+				continue;
+			}
+
+			i = _suffix;
+			while (i > memory && Traits::eq(_pattern[i-1], first[i-1 + j]))
+				--i;
+			if (i <= memory)
+				return first + j;
+			j += _period;
+			if (_periodic)
+				memory = _length - _period;
+		}
+		return last;
+	}
+
+	/**< Interface of the standard searchers. */
+	template <typename RandomIt>
+	constexpr STD::pair<RandomIt, RandomIt> operator()(RandomIt first, RandomIt last) const {
+		auto it = search(first, last);
+		if (it == last)
+			return {last, last};
+		return {it, it + _length};
+	}
+};
+
+template <typename Char, typename Traits = CharTraits<Char>>
+using Searcher = BasicSearcher<Char const*, Traits>;
+
+/**< Counterpart of STD::search taking a searcher. */
+template <typename ForwardIt, typename SearcherT>
+constexpr ForwardIt search(ForwardIt first, ForwardIt last, SearcherT const& searcher) {
+	return searcher(first, last).first;
+}
+
+}
@@ -9,8 +9,11 @@
 #include "Bitset.hxx"
 #include "ChunkPool.hxx"
 #include "StableVector.hxx"
+#include "SizeClassPool.hxx"
 #include "FlatSet.hxx"
 #include "FlatMap.hxx"
+#include "StaticHashMap.hxx"
+#include "StaticHashSet.hxx"
 #include "StaticPrintf.hxx"
 
 // Check ADL range access
@@ -160,6 +163,144 @@ constexpr auto k() {
 }
 static_assert( k() == StableFlatMultiMap<int, char, 10, STD::greater<>>{{3, 'c'}, {3, 'd'}, {2, 'b'}, {2, 'c'}} );
 
+constexpr auto l() {
+	constexpr FlatMap<String, int, 16> keywords{{"if", 1}, {"else", 2}, {"while", 3}, {"for", 4}, {"return", 5}};
+	StaticHashMap<String, int, 16> map(keywords);
+	assert( map.size() == 5 && Constainer::equal(map.begin(), map.end(), keywords.begin(), keywords.end()) );
+	assert( map.at("while") == 3 && map.find("return")->value() == 5 );
+	assert( map.find("do") == map.end() && !map.contains("") && map.count("for") == 1 );
+	assert( keywords.contains("else") && !keywords.contains("do") );
+
+	StaticHashSet<int, 10> set{5, 3, 5, 17, 8, 0, -2, 3, 1000, 42};
+	assert( set.size() == 8 && set.contains(-2) && set.contains(1000) && !set.contains(4) );
+	assert( *set.begin() == 5 && *set.nth(2) == 17 );
+	StaticHashSet<int, 4> empty;
+	assert( empty.find(0) == empty.end() && !empty.contains(1) );
+	return map.at("if");
+}
+static_assert( l() == 1 );
+static_assert( STD::is_same<StaticHashSet<int, 4>::iterator, StaticHashSet<int, 4>::const_iterator>{} );
+static_assert( !STD::is_same<StaticHashMap<int, int, 4>::iterator, StaticHashMap<int, int, 4>::const_iterator>{} );
+
+constexpr auto m() {
+	FlatSet<int, 64, STD::less<>, EytzingerLayout> set(ordered_unique_range, {1, 3, 5, 7, 9, 11, 13, 15, 17, 19});
+	set.insert(8);
+	set.erase(15);
+	// 1 3 5 7 8 9 11 13 17 19
+	assert( *set.lower_bound(8) == 8 && *set.lower_bound(10) == 11 && *set.upper_bound(13) == 17 );
+	assert( set.lower_bound(20) == set.end() && set.upper_bound(0) == set.begin() );
+	assert( set.contains(17) && !set.contains(15) && set.count(1) == 1 );
+
+	FlatMultiMap<int, char, 64, STD::less<>, EytzingerLayout> map{{2, 'a'}, {1, 'b'}, {2, 'c'}, {4, 'd'}};
+	auto range = map.equal_range(2);
+	assert( range.first == map.begin()+1 && range.second == map.begin()+3 );
+	return set;
+}
+static_assert( m() == FlatSet<int, 20>{1, 3, 5, 7, 8, 9, 11, 13, 17, 19} );
+
+constexpr auto n() {
+	Vector<int, 100> v;
+	for (int i = 0; i != 100; ++i)
+		v.push_back((i * 37) % 101 - 50);
+	sort(begin(v), end(v));
+	assert( is_sorted(begin(v), end(v)) && v.front() == -50 && v.back() == 50 && v[64] == 15 );
+	Constainer::sort(rbegin(v), rend(v));
+	assert( Constainer::is_sorted(begin(v), end(v), STD::greater<>{}) );
+
+	FlatSet<int, 16> set{9, 2, 7, 2, 5, 9, 1};
+	set.insert({4, 7, 3, 10, 3});
+	FlatMultiSet<int, 16> multi{5, 1, 5, 8};
+	multi.merge(set);
+	// 1 1 2 3 4 5 5 5 7 8 9 10
+	assert( multi.count(5) == 3 && multi.count(1) == 2 && multi.size() == 12 );
+	set.merge(multi);
+
+	// More elements than fit, but not after deduplication
+	FlatSet<int, 4> small{3, 1};
+	small.insert({2, 3, 1, 2, 4, 4, 1, 3, 2, 4});
+	assert( small.size() == 4 && *small.begin() == 1 && *small.nth(3) == 4 );
+	return set;
+}
+static_assert( n() == FlatSet<int, 16>{1, 2, 3, 4, 5, 7, 8, 9, 10} );
+
+constexpr auto o() {
+	Bitset<200> b;
+	b.set(60, 130, true);
+	assert( b.count() == 71 && b.count(0, 63) == 4 && b.count(128, 199) == 3 );
+	assert( b.find_first() == 60 && b.find_last() == 130 && b.find_first(false) == 0 && b.find_last(false) == 199 );
+	assert( b.find_next(63) == 64 && b.find_next(130) == 200 && b.find_next(59, false) == 131 );
+	b.reset(64, 127);
+	assert( b.count() == 7 && b.find_next(63) == 128 );
+	b <<= 70;
+	assert( b.find_first() == 130 && b.find_last() == 199 && b.count() == 6 );
+	b >>= 129;
+	assert( b.find_first() == 1 && b.count(1, 4) == 4 && b.find_last() == 70 && (~b).count() == 194 );
+	assert( b.set().all() && b.count() == 200 && b.leading(1) == 200 );
+	b.flip(0, 199);
+	return b.none() && Bitset<128>().set().all() && Bitset<128>().set().count() == 128;
+}
+static_assert( o() );
+
+constexpr auto p() {
+	ChunkPool<int, 8> c;
+	int* ptrs[8] {};
+	c.grab_n(8, ptrs);
+	assert( c.used() == 8 && !c.available() );
+	c.free_n(ptrs+2, 3);
+	assert( c.used() == 5 && c.grab() == ptrs[4] );
+
+	SizeClassPool<int, 64, 1, 4, 16> pool;
+	auto run = pool.allocate(3);
+	run[2] = 7;
+	assert( pool.allocate(16) != nullptr && pool.used_blocks() == 2 );
+	pool.deallocate(run, 3);
+	assert( pool.allocate(4) == run && *run == 0 );
+	assert( pool.available() == 64 && pool.available(3) == 15 && pool.available(16) == 3 );
+	SizeClassPool<int, 8, 1>{}.grab_n(8, ptrs);
+
+	BasicStableVector<int, SizeClassPool<int, 32, 1, 8>> s(20, 3);
+	s.erase(s.begin()+5, s.begin()+18);
+	s.insert(s.begin()+1, {1, 2});
+	return s;
+}
+static_assert( p() == StableVector<int, 10>{3, 1, 2, 3, 3, 3, 3, 3, 3} );
+
+constexpr auto q() {
+	BasicStableVector<int, ChunkPool<int, 40>, TieredIndex<4>> s;
+	for (int i = 0; i != 30; ++i)
+		s.insert(s.begin() + s.size()/2, i);
+	// 1 3 5 ... 27 29 28 26 ... 2 0
+	auto& ref = s[14];
+	auto it = s.begin()+20;
+	s.erase(s.begin()+2, s.begin()+5);
+	s.erase(s.begin());
+	s.insert(s.begin()+3, {-1, -2});
+	assert( ref == 29 && *it == 18 && it - s.begin() == 18 && s.end() - it == 10 );
+	assert( s.front() == 3 && s.back() == 0 && s[3] == -1 && s.size() == 28 );
+	return s;
+}
+static_assert( q() == StableVector<int, 40>{3, 11, 13, -1, -2, 15, 17, 19, 21, 23, 25, 27, 29, 28, 26, 24, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2, 0} );
+
+constexpr auto r() {
+	String s = "abaabaabbabaababaabaababaab";
+	assert( s.find("abaababaab") == 9 && s.find("abaababaab", 10) == 17 && s.find("aaa") == String::npos );
+	assert( s.rfind("abaababaab") == 17 && s.rfind("abaab", 20) == 14 && s.rfind("bb", 6) == String::npos );
+
+	constexpr char pattern[] = "aab";
+	Searcher<char> searcher(pattern, pattern+3);
+	String64 lines[] {"xaabx", "ab", "aaaab"};
+	assert( lines[0].find(searcher) == 1 && lines[1].find(searcher) == String::npos && lines[2].find(searcher) == 2 );
+	assert( *search(s.begin()+4, s.end(), searcher) == 'a' );
+
+	BasicString<char, 512> long_string;
+	long_string.append(300, 'a').append("ab");
+	assert( long_string.find("aaaab") == 297 && long_string.find("ab", 10) == 300 && long_string.find("ba") == String::npos );
+
+	assert( s.find_first_of("xyb", 2) == 4 && s.find_last_not_of("b") == 25 && s.find_first_not_of("ab") == String::npos );
+	return s.find("") == 0 && String().find("") == 0 && s.find("", s.size()+1) == String::npos;
+}
+static_assert( r() );
+
 
 static_assert( strToInt<int>(" 6849.") == 6849 );
 static_assert( strToInt<signed char>(" -128aefws") == -128 );
@@ -181,6 +322,15 @@ static_assert( strToFloat<double     >("-1.18973e+4932") == -STD::numeric_limits
 static_assert( strToFloat<long double>("-1.18973e+4932") != -STD::numeric_limits<long double>::infinity() );
 static_assert( strToFloat<double>("-0x.8p-1") == -0.25 );
 
+// Decimal input is rounded correctly, including halfway cases and digits beyond those that fit into 64 bits
+static_assert( strToFloat<double>("9007199254740993") == 9007199254740992. );
+static_assert( strToFloat<double>("9007199254740993.00000000000000000000001") == 9007199254740994. );
+static_assert( strToFloat<double>("2.2250738585072011e-308") == 2.2250738585072011e-308 );
+static_assert( strToFloat<double>("4.9406564584124654e-324") == STD::numeric_limits<double>::denorm_min() );
+static_assert( strToFloat<double>("1e-400") == 0 && strToFloat<double>("-1e400") == -STD::numeric_limits<double>::infinity() );
+static_assert( strToFloat<float>("1.17549435e-38") == 1.17549435e-38f );
+static_assert( strToFloat<float>("3.4028235677973366e38") == STD::numeric_limits<float>::max() );
+
 static_assert( abs(STD::numeric_limits<double>::infinity())  == STD::numeric_limits<double>::infinity() );
 static_assert( abs(-STD::numeric_limits<double>::infinity()) == STD::numeric_limits<double>::infinity() );
 
@@ -200,3 +350,95 @@ namespace TC001
 
 static_assert( 0.123456789456 == strToFloat<double>("%a\n"_ConstainerStaticPrintf(0.123456789456).c_str()) );
 
+static_assert( "%.17e %.0f %.0f %.1f"_ConstainerStaticPrintf(0.1, 0.5, 2.5, 0.25) == "1.00000000000000006e-01 0 2 0.2" );
+static_assert( "%.3g %#.3g %g %g %.20g"_ConstainerStaticPrintf(1e-5, 1., 1e5, 1e6, 1e23) == "1e-05 1.00 100000 1e+06 9.9999999999999991611e+22" );
+static_assert( "%f %e"_ConstainerStaticPrintf(-0., 1e300) == "-0.000000 1.000000e+300" );
+static_assert( "%#x %-5d|%+05d %.3s %c %%"_ConstainerStaticPrintf(255, -3, 42, "abcdef", 'z') == "0xff -3   |+0042 abc z %" );
+static_assert( "%08.3d|%06.0x|%05u"_ConstainerStaticPrintf(-70239, 0, 7u) == "  -70239|      |00007" );
+
+constexpr bool formatsToSinks() {
+	constexpr auto format = "%s=%08.3f"_ConstainerStaticPrintf;
+	char buf[8] {};
+	BasicString<char, 1024> str = "x: ";
+	format.append_to(str, "pi", 3.14159);
+	// Output is not limited to 256 characters.
+	"%1000d"_ConstainerStaticPrintf.append_to(str, 1);
+	return format.formatted_size("pi", 3.14159) == 11
+	    && format.format_to_n(buf, sizeof buf, "pi", 3.14159) == 11 && buf[7] == '.'
+	    && str.size() == 1014 && str.substr(0, 14) == "x: pi=0003.142" && str.back() == '1';
+}
+static_assert( formatsToSinks() );
+
+// The shortest representation converts back to the same value
+static_assert( toString(0.1) == "0.1" && toString(-0.) == "-0" && toString(0.3f) == "0.3" );
+static_assert( toString(1e23) == "1e+23" && toString(5e-324) == "5e-324" && toString(1e22) == "1e+22" );
+static_assert( toString(123456789.) == "123456789" && toString(73318368.f) == "73318368" );
+static_assert( toString(STD::numeric_limits<long double>::max()) == "1.189731495357231765e+4932"
+            && toString(STD::numeric_limits<long double>::denorm_min()) == "4e-4951" );
+template <typename Float>
+constexpr bool roundTrips(Float x) {
+	return strToFloat<Float>(toString(x).c_str()) == x && strToFloat<Float>(toString(-x).c_str()) == -x;
+}
+/**< Every stride-th power of two from denorm_min on, with both neighbours, and the largest values. */
+template <typename Float>
+constexpr bool roundTripsAtPowersOfTwo(int stride) {
+	using limits = STD::numeric_limits<Float>;
+	constexpr Float eps = limits::epsilon(), tiny = limits::denorm_min();
+	constexpr int last = limits::max_exponent - limits::min_exponent + limits::digits - 1;
+	Float p = tiny;
+	for (int i = 0; ; p *= 2) {
+		if (i % stride == 0 && !(roundTrips(p) && roundTrips(p < limits::min()? p + tiny : p + p*eps)
+		                                       && roundTrips(p <= limits::min()? p - tiny : p - p*eps/2)))
+			return false;
+		if (i++ == last)
+			break;
+	}
+	return roundTrips(limits::max()) && roundTrips(limits::max() - p*eps)
+	    && roundTrips(limits::min()) && roundTrips(limits::min() - tiny);
+}
+static_assert( roundTripsAtPowersOfTwo<float>(5) && roundTripsAtPowersOfTwo<double>(23) );
+constexpr bool roundTrips() {
+	double values[] {1./3, 2./3e-300, 1.7976931348623157e308, 2.2250738585072009e-308, 123.456, 9007199254740993.,
+	                 5e-324, 1e23, 8.41e21, 5.708990770823839e-308, 2.9802322387695312e-8, 9.5e-5};
+	for (auto x : values)
+		if (!roundTrips(x))
+			return false;
+	float floats[] {1.f/3, 7.038531e-26f, 8.589973e9f, 1.4e-45f, 3.4028235e38f, 1.1754942e-38f, 16777217.f, 0.3f};
+	for (auto x : floats)
+		if (!roundTrips(x))
+			return false;
+	return true;
+}
+static_assert( roundTrips() );
+
+// Decimal input close to or exactly halfway between two values
+template <typename Float>
+struct ParseCase {
+	char const* text;
+	Float value;
+};
+constexpr bool parsesHalfwayCases() {
+	constexpr double dmax = STD::numeric_limits<double>::max(), dtiny = STD::numeric_limits<double>::denorm_min();
+	ParseCase<double> doubles[] {
+		{"2.2250738585072011e-308", 2.2250738585072011e-308}, {"2.2250738585072012e-308", 2.2250738585072012e-308},
+		{"9007199254740993", 9007199254740992.}, {"9007199254740993.000000000000000000001", 9007199254740994.},
+		{"1.00000000000000011102230246251565404236316680908203125", 1.},
+		{"1.00000000000000011102230246251565404236316680908203126", 1. + STD::numeric_limits<double>::epsilon()},
+		{"2.4703282292062327e-324", 0.}, {"2.4703282292062328e-324", dtiny}, {"1.7976931348623158e308", dmax},
+		{"7.2057594037927933e16", 72057594037927936.}, {"123456789012345678901234567890", 1.2345678901234568e29}};
+	for (auto c : doubles)
+		if (strToFloat<double>(c.text) != c.value)
+			return false;
+	constexpr float ftiny = STD::numeric_limits<float>::denorm_min();
+	ParseCase<float> floats[] {
+		{"1.000000059604644775390625", 1.f}, {"1.00000005960464477539062501", 1.f + STD::numeric_limits<float>::epsilon()},
+		{"7.00649232162408535461864791644958065640130970938257885878534141944895541342930300743319094181060791015625e-46", 0.f},
+		{"7.0064923216240854e-46", ftiny}, {"3.4028235677973366e38", 3.4028235e38f},
+		{"16777217", 16777216.f}, {"1.17549428e-38", 1.17549428e-38f}};
+	for (auto c : floats)
+		if (strToFloat<float>(c.text) != c.value)
+			return false;
+	return true;
+}
+static_assert( parsesHalfwayCases() );
+
@@ -0,0 +1,341 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+/**< Runtime benchmarks of Constainer against the standard library equivalents. The results are written to stdout
+     as a JSON array with one object per measurement:
+
+         {"benchmark": "flatmap.find", "library": "constainer", "size": 1024, "distribution": "random",
+          "iterations": 2048, "ns_per_op": 18.4, "comparisons_per_op": 10.9, "copies_per_op": 0, "moves_per_op": 0}
+
+     The operation counts are only reported for Constainer, and only if CONSTAINER_COUNT_OPERATIONS is defined,
+     which slows down the timed code. The optional argument restricts the run to benchmarks whose name contains it.
+     From the repository root:
+
+         g++ -std=c++17 -O2 -I. bench/Benchmark.cxx -o benchmark && ./benchmark flatmap > flatmap.json */
+
+#include "FlatMap.hxx"
+#include "Parser.hxx"
+#include "StableVector.hxx"
+#include "StaticPrintf.hxx"
+#include "String.hxx"
+#include "Vector.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Constainer;
+
+namespace {
+
+enum class Distribution {ascending, descending, random};
+
+char const* name(Distribution d) {
+	switch (d) {
+		case Distribution::ascending:  return "ascending";
+		case Distribution::descending: return "descending";
+		default:                       return "random";
+	}
+}
+
+/**< The keys 0, 2, ..., 2(n-1) in the order given by d. Odd keys are absent from containers filled with these. */
+std::vector<int> keys(std::size_t n, Distribution d) {
+	std::vector<int> v(n);
+	for (std::size_t i = 0; i != n; ++i)
+		v[i] = 2*i;
+	if (d == Distribution::descending)
+		std::reverse(v.begin(), v.end());
+	else if (d == Distribution::random)
+		std::shuffle(v.begin(), v.end(), std::mt19937_64(n));
+	return v;
+}
+
+template <typename T>
+void doNotOptimize(T const& value) {
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+class Runner {
+	using Clock = std::chrono::steady_clock;
+
+	char const* _filter;
+	bool _first = true;
+
+public:
+	explicit Runner(char const* filter) : _filter(filter) {std::puts("[");}
+	~Runner() {std::puts("\n]");}
+
+	/**< Times calls of f, each of which performs ops operations, for at least 50ms, and prints the time per
+	     operation. setup is called before every call of f and is not timed. */
+	template <typename Setup, typename F>
+	void run(char const* benchmark, char const* library, std::size_t size, char const* distribution,
+	         std::size_t ops, Setup setup, F f) {
+		if (_filter && !std::strstr(benchmark, _filter))
+			return;
+
+		setup();
+		f();
+		Clock::duration total{};
+		std::size_t calls = 0;
+		while (total < std::chrono::milliseconds(50) || calls < 3) {
+			setup();
+			auto start = Clock::now();
+			f();
+			total += Clock::now() - start;
+			++calls;
+		}
+		double ns = std::chrono::duration<double, std::nano>(total).count() / (calls * ops);
+
+		std::printf("%s\t{\"benchmark\": \"%s\", \"library\": \"%s\", \"size\": %zu, \"distribution\": \"%s\", "
+		            "\"iterations\": %zu, \"ns_per_op\": %.3f",
+		            _first? "" : ",\n", benchmark, library, size, distribution, calls * ops, ns);
+		_first = false;
+
+	#ifdef CONSTAINER_COUNT_OPERATIONS
+		if (!std::strcmp(library, "std")) {
+			std::fputs("}", stdout);
+			return;
+		}
+		setup();
+		resetOperationCounts();
+		f();
+		auto counts = operationCounts();
+		std::printf(", \"comparisons_per_op\": %.3f, \"copies_per_op\": %.3f, \"moves_per_op\": %.3f",
+		            double(counts.comparisons) / ops, double(counts.copies) / ops, double(counts.moves) / ops);
+	#endif
+		std::fputs("}", stdout);
+	}
+
+	template <typename F>
+	void run(char const* benchmark, char const* library, std::size_t size, char const* distribution,
+	         std::size_t ops, F f) {
+		run(benchmark, library, size, distribution, ops, []{}, f);
+	}
+};
+
+Distribution const distributions[] = {Distribution::ascending, Distribution::descending, Distribution::random};
+
+/**< push_back, and insertion and erasure at the front, which shift all elements. */
+template <std::size_t N>
+void vectorBenchmarks(Runner& runner) {
+	static Vector<int, N> vec;
+	static std::vector<int> std_vec;
+	std_vec.reserve(N);
+
+	runner.run("vector.push_back", "constainer", N, "-", N, [] {
+		vec.clear();
+		for (std::size_t i = 0; i != N; ++i)
+			vec.push_back(i);
+		doNotOptimize(vec.data());
+	});
+	runner.run("vector.push_back", "std", N, "-", N, [] {
+		std_vec.clear();
+		for (std::size_t i = 0; i != N; ++i)
+			std_vec.push_back(i);
+		doNotOptimize(std_vec.data());
+	});
+
+	runner.run("vector.insert_front", "constainer", N, "-", N, [] {
+		vec.clear();
+		for (std::size_t i = 0; i != N; ++i)
+			vec.insert(vec.begin(), i);
+		doNotOptimize(vec.data());
+	});
+	runner.run("vector.insert_front", "std", N, "-", N, [] {
+		std_vec.clear();
+		for (std::size_t i = 0; i != N; ++i)
+			std_vec.insert(std_vec.begin(), i);
+		doNotOptimize(std_vec.data());
+	});
+
+	runner.run("vector.erase_front", "constainer", N, "-", N, [] {vec.assign(N, 1);}, [] {
+		while (!vec.empty())
+			vec.erase(vec.begin());
+		doNotOptimize(vec.data());
+	});
+	runner.run("vector.erase_front", "std", N, "-", N, [] {std_vec.assign(N, 1);}, [] {
+		while (!std_vec.empty())
+			std_vec.erase(std_vec.begin());
+		doNotOptimize(std_vec.data());
+	});
+}
+
+/**< Insertion in the middle, which moves no elements in a StableVector but updates its index. */
+template <typename Vec, std::size_t N>
+void stableVectorBenchmarks(Runner& runner, char const* library) {
+	static Vec vec;
+
+	runner.run("stablevector.insert_middle", library, N, "-", N, [] {vec.clear();}, [] {
+		for (std::size_t i = 0; i != N; ++i)
+			vec.insert(vec.begin() + vec.size()/2, i);
+		doNotOptimize(vec.size());
+	});
+	runner.run("stablevector.erase_middle", library, N, "-", N, [] {
+		vec.clear();
+		for (std::size_t i = 0; i != N; ++i)
+			vec.push_back(i);
+	}, [] {
+		while (!vec.empty())
+			vec.erase(vec.begin() + vec.size()/2);
+		doNotOptimize(vec.size());
+	});
+}
+
+template <typename Map, std::size_t N>
+void mapBenchmarks(Runner& runner, char const* library) {
+	static Map map;
+	for (auto d : distributions) {
+		static std::vector<int> order, lookups;
+		order = keys(N, d);
+		lookups = keys(N, Distribution::random);
+		for (auto& k : lookups)
+			k += k % 4 == 0; // Half of the lookups miss
+
+		runner.run("flatmap.insert", library, N, name(d), N, [] {map.clear();}, [] {
+			for (auto k : order)
+				map.insert_or_assign(k, k);
+			doNotOptimize(map.size());
+		});
+		runner.run("flatmap.find", library, N, name(d), N, [] {
+			map.clear();
+			for (auto k : order)
+				map.insert_or_assign(k, k);
+		}, [] {
+			std::size_t found = 0;
+			for (auto k : lookups)
+				found += map.find(k) != map.end();
+			doNotOptimize(found);
+		});
+		runner.run("flatmap.erase", library, N, name(d), N, [] {
+			map.clear();
+			for (auto k : order)
+				map.insert_or_assign(k, k);
+		}, [] {
+			for (auto k : order)
+				map.erase(k);
+			doNotOptimize(map.size());
+		});
+	}
+}
+
+/**< Searches a haystack over a small alphabet for a pattern that only occurs near its end and ends with a common
+     character, which defeats the skip loop, and for a single rare character. */
+template <std::size_t N>
+void searchBenchmarks(Runner& runner) {
+	static std::string std_haystack;
+	static BasicString<char, N+1> haystack;
+	static char const* pattern;
+
+	std::mt19937_64 gen(N);
+	std_haystack.resize(N);
+	for (auto& c : std_haystack)
+		c = "ab"[gen() % 2];
+	std_haystack.replace(N - 16, 16, "abaabbzabbbaabab");
+	haystack.assign(std_haystack.data(), N);
+
+	char const* const patterns[][2] = {{"string.find", "aabbzabbb"}, {"string.find_rare", "z"}};
+	for (auto& p : patterns) {
+		pattern = p[1];
+		runner.run(p[0], "constainer", N, "-", 1, [] {doNotOptimize(haystack.find(pattern));});
+		runner.run(p[0], "std", N, "-", 1, [] {doNotOptimize(std_haystack.find(pattern));});
+	}
+
+	static char const set[] = "0123456789z";
+	runner.run("string.find_first_of", "constainer", N, "-", 1, [] {doNotOptimize(haystack.find_first_of(set));});
+	runner.run("string.find_first_of", "std", N, "-", 1, [] {doNotOptimize(std_haystack.find_first_of(set));});
+}
+
+void parseBenchmarks(Runner& runner) {
+	constexpr std::size_t n = 4096;
+	static std::vector<std::string> ints, floats;
+	std::mt19937_64 gen(n);
+	for (std::size_t i = 0; i != n; ++i) {
+		ints.push_back(std::to_string(std::int64_t(gen()) >> (gen() % 64)));
+		char buf[32];
+		std::snprintf(buf, sizeof buf, "%.*g", int(gen() % 17 + 1), std::ldexp(double(gen() >> 11), int(gen() % 200) - 150));
+		floats.push_back(buf);
+	}
+
+	runner.run("parse.int", "constainer", n, "random", n, [] {
+		for (auto& s : ints)
+			doNotOptimize(strToInt<long long>(s.data(), s.size()));
+	});
+	runner.run("parse.int", "std", n, "random", n, [] {
+		for (auto& s : ints)
+			doNotOptimize(std::strtoll(s.data(), nullptr, 10));
+	});
+	runner.run("parse.float", "constainer", n, "random", n, [] {
+		for (auto& s : floats)
+			doNotOptimize(strToFloat<double>(s.data(), s.size()));
+	});
+	runner.run("parse.float", "std", n, "random", n, [] {
+		for (auto& s : floats)
+			doNotOptimize(std::strtod(s.data(), nullptr));
+	});
+}
+
+void formatBenchmarks(Runner& runner) {
+	constexpr std::size_t n = 4096;
+	static std::vector<long long> ints;
+	static std::vector<double> floats;
+	std::mt19937_64 gen(n);
+	for (std::size_t i = 0; i != n; ++i) {
+		ints.push_back(std::int64_t(gen()) >> (gen() % 64));
+		floats.push_back(std::ldexp(double(gen() >> 11), int(gen() % 200) - 150));
+	}
+
+	static char buf[128];
+	runner.run("format.int", "constainer", n, "random", n, [] {
+		for (auto i : ints)
+			doNotOptimize("%d"_ConstainerStaticPrintf.format_to_n(buf, sizeof buf, i));
+	});
+	runner.run("format.int", "std", n, "random", n, [] {
+		for (auto i : ints)
+			doNotOptimize(std::snprintf(buf, sizeof buf, "%lld", i));
+	});
+	runner.run("format.float", "constainer", n, "random", n, [] {
+		for (auto x : floats)
+			doNotOptimize("%.6e"_ConstainerStaticPrintf.format_to_n(buf, sizeof buf, x));
+	});
+	runner.run("format.float", "std", n, "random", n, [] {
+		for (auto x : floats)
+			doNotOptimize(std::snprintf(buf, sizeof buf, "%.6e", x));
+	});
+	runner.run("format.mixed", "constainer", n, "random", n, [] {
+		for (std::size_t i = 0; i != n; ++i)
+			doNotOptimize("%s:%5d|%-8.3f"_ConstainerStaticPrintf.format_to_n(buf, sizeof buf, "key", int(ints[i]), floats[i]));
+	});
+	runner.run("format.mixed", "std", n, "random", n, [] {
+		for (std::size_t i = 0; i != n; ++i)
+			doNotOptimize(std::snprintf(buf, sizeof buf, "%s:%5d|%-8.3f", "key", int(ints[i]), floats[i]));
+	});
+}
+
+template <std::size_t N>
+void sizedBenchmarks(Runner& runner) {
+	vectorBenchmarks<N>(runner);
+	stableVectorBenchmarks<StableVector<int, N>, N>(runner, "constainer");
+	stableVectorBenchmarks<TieredStableVector<int, N>, N>(runner, "constainer-tiered");
+	mapBenchmarks<FlatMap<int, int, N>, N>(runner, "constainer");
+	mapBenchmarks<FlatMap<int, int, N, std::less<int>, EytzingerLayout>, N>(runner, "constainer-eytzinger");
+	mapBenchmarks<std::map<int, int>, N>(runner, "std");
+	searchBenchmarks<N*16>(runner);
+}
+
+}
+
+int main(int argc, char** argv) {
+	Runner runner(argc > 1? argv[1] : nullptr);
+	sizedBenchmarks<  16>(runner);
+	sizedBenchmarks< 256>(runner);
+	sizedBenchmarks<4096>(runner);
+	parseBenchmarks(runner);
+	formatBenchmarks(runner);
+}
@@ -0,0 +1,110 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+/**< A workload that is evaluated at compile time, for measuring the cost of constant evaluation. The workload is
+     selected by defining CONSTAINER_BENCH_OPERATION to the name of one of the functions below and
+     CONSTAINER_BENCH_SIZE to the number of elements. bench/constexprSweep.sh compiles this file for several
+     operations and sizes. */
+
+#include "FlatMap.hxx"
+#include "Parser.hxx"
+#include "StableVector.hxx"
+#include "StaticPrintf.hxx"
+#include "String.hxx"
+#include "Vector.hxx"
+
+using namespace Constainer;
+
+namespace {
+
+/**< Pseudo-random keys in [0, n), so that insertions hit all positions. */
+constexpr int key(STD::size_t i, STD::size_t n) {
+	return (i * 2654435761u) % n;
+}
+
+template <STD::size_t N>
+constexpr int vectorPushBack() {
+	Vector<int, N> vec;
+	for (STD::size_t i = 0; i != N; ++i)
+		vec.push_back(i);
+	return vec.back();
+}
+
+template <STD::size_t N>
+constexpr int vectorInsertFront() {
+	Vector<int, N> vec;
+	for (STD::size_t i = 0; i != N; ++i)
+		vec.insert(vec.begin(), i);
+	return vec.back();
+}
+
+template <STD::size_t N>
+constexpr int stableVectorInsertMiddle() {
+	TieredStableVector<int, N> vec;
+	for (STD::size_t i = 0; i != N; ++i)
+		vec.insert(vec.begin() + vec.size()/2, i);
+	return vec.front();
+}
+
+template <STD::size_t N>
+constexpr int flatMapInsert() {
+	FlatMap<int, int, N> map;
+	for (STD::size_t i = 0; i != N; ++i)
+		map.insert_or_assign(key(i, N), i);
+	return map.size();
+}
+
+template <STD::size_t N>
+constexpr int flatMapFind() {
+	FlatMap<int, int, N> map;
+	for (STD::size_t i = 0; i != N; ++i)
+		map.insert_or_assign(i, i);
+	int found = 0;
+	for (STD::size_t i = 0; i != N; ++i)
+		found += map.find(key(i, 2*N)) != map.end();
+	return found;
+}
+
+template <STD::size_t N>
+constexpr int stringFind() {
+	BasicString<char, N+1> haystack;
+	haystack.append(N, 'a');
+	haystack[N-1] = 'b';
+	return haystack.find("aaaab");
+}
+
+/**< The digits are varied so that the compiler cannot reuse the result of an earlier call. */
+template <STD::size_t N>
+constexpr int parseInt() {
+	char digits[] = "-123456789";
+	int sum = 0;
+	for (STD::size_t i = 0; i != N; ++i) {
+		digits[9] = '0' + i % 10;
+		sum += strToInt<int>(digits) < 0;
+	}
+	return sum;
+}
+
+template <STD::size_t N>
+constexpr int parseFloat() {
+	char digits[] = "3.14159265358979e-3";
+	int sum = 0;
+	for (STD::size_t i = 0; i != N; ++i) {
+		digits[15] = '0' + i % 10;
+		sum += strToFloat<double>(digits) > 0;
+	}
+	return sum;
+}
+
+template <STD::size_t N>
+constexpr int format() {
+	int length = 0;
+	for (STD::size_t i = 0; i != N; ++i)
+		length += "%d:%5.2f|%s"_ConstainerStaticPrintf(int(i), 2.5, "abc").size();
+	return length;
+}
+
+}
+
+static_assert(CONSTAINER_BENCH_OPERATION<CONSTAINER_BENCH_SIZE>() >= 0, "");
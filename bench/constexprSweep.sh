@@ -0,0 +1,80 @@
+#!/bin/sh
+# Copyright 2015, 2016 Robert Haberlach
+#	Distributed under the Boost Software License, Version 1.0.
+#	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt)
+#
+# Measures the cost of constant evaluation of the workloads in ConstexprCost.cxx and writes a JSON array to stdout,
+# with one object per operation and size:
+#
+#     {"operation": "flatMapInsert", "size": 256, "compile_ms": 812, "steps": 1843200, "steps_per_element": 7200.0}
+#
+# compile_ms is the wall time of a syntax-only compilation. steps is the smallest -fconstexpr-ops-limit (GCC) or
+# -fconstexpr-steps (Clang) that the workload compiles with, found by bisection to within 1%. The limit applies to
+# each constant expression separately, and errors in other constant expressions are ignored. However, a workload
+# that reads the floating point tables fails along with them, so it cannot be measured below their cost.
+#
+# Usage, from the repository root:
+#
+#     CXX=clang++ SIZES="64 256 1024" bench/constexprSweep.sh flatMapInsert flatMapFind > sweep.json
+#
+# Without arguments, all operations are measured.
+
+CXX=${CXX:-g++}
+SIZES=${SIZES:-"16 64 256"}
+OPERATIONS=${*:-"vectorPushBack vectorInsertFront stableVectorInsertMiddle flatMapInsert flatMapFind
+                  stringFind parseInt parseFloat format"}
+MAX_STEPS=1099511627776
+
+bench=$(dirname "$0")
+root=$bench/..
+
+if "$CXX" --version | grep -q clang; then
+	limit_flag=-fconstexpr-steps
+else
+	limit_flag=-fconstexpr-ops-limit
+fi
+
+# compiles OPERATION SIZE LIMIT: whether the workload itself is a constant expression
+compiles() {
+	! "$CXX" -std=c++17 -fsyntax-only -I"$root" "$limit_flag=$3" \
+	         -DCONSTAINER_BENCH_OPERATION="$1" -DCONSTAINER_BENCH_SIZE="$2" "$bench/ConstexprCost.cxx" 2>&1 \
+	  | grep -q "ConstexprCost.cxx:[0-9]*:[0-9]*: error"
+}
+
+milliseconds() {
+	echo $(( $(date +%s%N) / 1000000 ))
+}
+
+separator=""
+echo "["
+for operation in $OPERATIONS; do
+	for size in $SIZES; do
+		start=$(milliseconds)
+		if ! compiles "$operation" "$size" $MAX_STEPS; then
+			echo "$operation with size $size does not compile" >&2
+			continue
+		fi
+		compile_ms=$(( $(milliseconds) - start ))
+
+		low=0
+		high=1024
+		while ! compiles "$operation" "$size" $high; do
+			low=$high
+			high=$(( high * 2 ))
+		done
+		while [ $(( high - low )) -gt $(( high / 100 )) ]; do
+			middle=$(( (low + high) / 2 ))
+			if compiles "$operation" "$size" $middle; then
+				high=$middle
+			else
+				low=$middle
+			fi
+		done
+
+		printf '%s\t{"operation": "%s", "size": %d, "compile_ms": %d, "steps": %d, "steps_per_element": %.1f}' \
+		       "$separator" "$operation" "$size" "$compile_ms" "$high" "$(awk "BEGIN {print $high / $size}")"
+		separator=",
+"
+	done
+done
+printf '\n]\n'
@@ -193,7 +193,18 @@ constexpr ForwardIt lower_bound(ForwardIt first, ForwardIt last, T const& value)
 	return Constainer::lower_bound(first, last, value, STD::less<>{});}
 template<typename ForwardIt, typename T, typename Comparator>
 constexpr ForwardIt upper_bound(ForwardIt first, ForwardIt last, T const& value, Comparator comp) {
-	return Constainer::lower_bound(first, last, value, makeNegateFunctor(comp));
+	auto count = Constainer::distance(first, last);
+	while (count > 0) {
+		auto intervall_size = count / 2;
+		auto it = Constainer::next(first, intervall_size);
+		if (!comp(value, *it)) {
+			first = ++it;
+			count -= intervall_size + 1;
+		}
+		else
+			count = intervall_size;
+	}
+	return first;
 }
 template<typename ForwardIt, typename T>
 constexpr ForwardIt upper_bound(ForwardIt first, ForwardIt last, T const& value) {
@@ -0,0 +1,173 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+namespace Constainer {
+
+template <typename ForwardIt, typename Compare>
+constexpr ForwardIt is_sorted_until(ForwardIt first, ForwardIt last, Compare comp) {
+	if (first != last)
+		for (auto next = first; ++next != last; first = next)
+			if (comp(*next, *first))
+				return next;
+	return last;
+}
+template <typename ForwardIt>
+constexpr ForwardIt is_sorted_until(ForwardIt first, ForwardIt last) {
+	return Constainer::is_sorted_until(first, last, STD::less<>{});}
+
+template <typename ForwardIt, typename Compare>
+constexpr bool is_sorted(ForwardIt first, ForwardIt last, Compare comp) {
+	return Constainer::is_sorted_until(first, last, comp) == last;}
+template <typename ForwardIt>
+constexpr bool is_sorted(ForwardIt first, ForwardIt last) {
+	return Constainer::is_sorted(first, last, STD::less<>{});}
+
+namespace detail {
+	template <typename RandomIt, typename Distance, typename Compare>
+	constexpr void sift_down(RandomIt first, Distance len, Distance hole, Compare& comp) {
+		auto value = STD::move(first[hole]);
+		for (Distance child; (child = 2*hole + 1) < len; hole = child) {
+			if (child + 1 < len && comp(first[child], first[child+1]))
+				++child;
+			if (!comp(value, first[child]))
+				break;
+			first[hole] = STD::move(first[child]);
+		}
+		first[hole] = STD::move(value);
+	}
+
+	template <typename RandomIt, typename Distance, typename Compare>
+	constexpr void sift_up(RandomIt first, Distance hole, Compare& comp) {
+		auto value = STD::move(first[hole]);
+		while (hole > 0) {
+			auto parent = (hole-1) / 2;
+			if (!comp(first[parent], value))
+				break;
+			first[hole] = STD::move(first[parent]);
+			hole = parent;
+		}
+		first[hole] = STD::move(value);
+	}
+}
+
+template <typename RandomIt, typename Compare>
+constexpr void make_heap(RandomIt first, RandomIt last, Compare comp) {
+	auto len = last - first;
+	for (auto i = len/2; i-- > 0;)
+		detail::sift_down(first, len, i, comp);
+}
+template <typename RandomIt>
+constexpr void make_heap(RandomIt first, RandomIt last) {
+	Constainer::make_heap(first, last, STD::less<>{});}
+
+template <typename RandomIt, typename Compare>
+constexpr void push_heap(RandomIt first, RandomIt last, Compare comp) {
+	if (last - first > 1)
+		detail::sift_up(first, last-first-1, comp);
+}
+template <typename RandomIt>
+constexpr void push_heap(RandomIt first, RandomIt last) {
+	Constainer::push_heap(first, last, STD::less<>{});}
+
+template <typename RandomIt, typename Compare>
+constexpr void pop_heap(RandomIt first, RandomIt last, Compare comp) {
+	if (last - first > 1) {
+		Constainer::iter_swap(first, --last);
+		detail::sift_down(first, last-first, decltype(last-first){0}, comp);
+	}
+}
+template <typename RandomIt>
+constexpr void pop_heap(RandomIt first, RandomIt last) {
+	Constainer::pop_heap(first, last, STD::less<>{});}
+
+template <typename RandomIt, typename Compare>
+constexpr void sort_heap(RandomIt first, RandomIt last, Compare comp) {
+	while (last - first > 1)
+		Constainer::pop_heap(first, last--, comp);
+}
+template <typename RandomIt>
+constexpr void sort_heap(RandomIt first, RandomIt last) {
+	Constainer::sort_heap(first, last, STD::less<>{});}
+
+namespace detail {
+	// Ranges of at most this many elements are left to insertion sort.
+	static constexpr STD::ptrdiff_t sortThreshold = 16;
+
+	template <typename RandomIt, typename Compare>
+	constexpr void insertion_sort(RandomIt first, RandomIt last, Compare& comp) {
+		if (first == last)
+			return;
+		for (auto i = first+1; i != last; ++i) {
+			auto value = STD::move(*i);
+			auto j = i;
+			for (; j != first && comp(value, j[-1]); --j)
+				*j = STD::move(j[-1]);
+			*j = STD::move(value);
+		}
+	}
+
+	/**< Moves the median of *a, *b and *c into *result. */
+	template <typename RandomIt, typename Compare>
+	constexpr void move_median_to_first(RandomIt result, RandomIt a, RandomIt b, RandomIt c, Compare& comp) {
+		if (comp(*a, *b)) {
+			if      (comp(*b, *c)) Constainer::iter_swap(result, b);
+			else if (comp(*a, *c)) Constainer::iter_swap(result, c);
+			else                   Constainer::iter_swap(result, a);
+		}
+		else if (comp(*a, *c)) Constainer::iter_swap(result, a);
+		else if (comp(*b, *c)) Constainer::iter_swap(result, c);
+		else                   Constainer::iter_swap(result, b);
+	}
+
+	/**< Hoare partition of [first, last) around *pivot, which must not lie in [first, last).
+	     The median-of-three selection guarantees that neither scan runs off the range. */
+	template <typename RandomIt, typename Compare>
+	constexpr RandomIt unguarded_partition(RandomIt first, RandomIt last, RandomIt pivot, Compare& comp) {
+		for (;;) {
+			while (comp(*first, *pivot))
+				++first;
+			--last;
+			while (comp(*pivot, *last))
+				--last;
+			if (!(first < last))
+				return first;
+			Constainer::iter_swap(first, last);
+			++first;
+		}
+	}
+
+	template <typename RandomIt, typename Compare>
+	constexpr void introsort_loop(RandomIt first, RandomIt last, int depth_limit, Compare& comp) {
+		while (last - first > sortThreshold) {
+			if (depth_limit-- == 0) {
+				Constainer::make_heap(first, last, comp);
+				Constainer::sort_heap(first, last, comp);
+				return;
+			}
+			move_median_to_first(first, first+1, first + (last-first)/2, last-1, comp);
+			auto cut = unguarded_partition(first+1, last, first, comp);
+			// Recurse into the right part, loop on the left one.
+			introsort_loop(cut, last, depth_limit, comp);
+			last = cut;
+		}
+	}
+}
+
+/**< Introsort: Quicksort with median-of-three pivots that falls back on heapsort once the recursion depth
+     exceeds 2*log2(n), which guarantees O(n log n) comparisons. Small partitions are finished by insertion sort. */
+template <typename RandomIt, typename Compare>
+constexpr void sort(RandomIt first, RandomIt last, Compare comp) {
+	int depth_limit = 0;
+	for (auto n = last-first; n > 1; n /= 2)
+		depth_limit += 2;
+	detail::introsort_loop(first, last, depth_limit, comp);
+	detail::insertion_sort(first, last, comp);
+}
+template <typename RandomIt>
+constexpr void sort(RandomIt first, RandomIt last) {
+	Constainer::sort(first, last, STD::less<>{});}
+
+}
@@ -205,6 +205,44 @@ constexpr void rotate(ForwardIt first, ForwardIt new_first, ForwardIt last)
 			new_first = next;
 	}
 }
+/**< Merges the sorted ranges [first, middle) and [middle, last) without a buffer: the larger range is split in
+     half, the other at the corresponding bound, and the inner parts are rotated past each other. This takes
+     O(n log n) moves and O(log n) stack. Stable, i.e. equivalent elements of [first, middle) stay in front. */
+template <typename BiDirIt, typename Compare>
+constexpr void inplace_merge(BiDirIt first, BiDirIt middle, BiDirIt last, Compare comp)
+{
+	// Elements that are already in place are skipped, which makes appending to a sorted range cheap.
+	if (first == middle || middle == last)
+		return;
+	first = Constainer::upper_bound(first, middle, *middle, comp);
+	if (first == middle)
+		return;
+	last = Constainer::lower_bound(middle, last, *Constainer::prev(middle), comp);
+
+	auto len1 = Constainer::distance(first, middle), len2 = Constainer::distance(middle, last);
+	if (len1 == 1 && len2 == 1) {
+		Constainer::iter_swap(first, middle);
+		return;
+	}
+
+	BiDirIt first_cut = first, second_cut = middle;
+	if (len1 > len2) {
+		Constainer::advance(first_cut, len1/2);
+		second_cut = Constainer::lower_bound(middle, last, *first_cut, comp);
+	}
+	else {
+		Constainer::advance(second_cut, len2/2);
+		first_cut = Constainer::upper_bound(first, middle, *second_cut, comp);
+	}
+	Constainer::rotate(first_cut, middle, second_cut);
+	auto new_middle = Constainer::next(first_cut, Constainer::distance(middle, second_cut));
+	Constainer::inplace_merge(first, first_cut, new_middle, comp);
+	Constainer::inplace_merge(new_middle, second_cut, last, comp);
+}
+template <typename BiDirIt>
+constexpr void inplace_merge(BiDirIt first, BiDirIt middle, BiDirIt last) {
+	Constainer::inplace_merge(first, middle, last, STD::less<>{});}
+
 template <typename ForwardIt, typename OutputIt>
 constexpr OutputIt rotate_copy(ForwardIt first, ForwardIt new_first,
                                ForwardIt last, OutputIt out) {
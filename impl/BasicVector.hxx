@@ -6,6 +6,7 @@
 
 #include "../Array.hxx"
 #include "../Assert.hxx"
+#include "OperationCounts.hxx"
 
 #include <algorithm>
 
@@ -20,15 +21,18 @@ struct DefaultCopyTraits {
 	using const_reference = T const&;
 
 	static constexpr pointer copy(pointer s1, const_pointer s2, STD::size_t n) {
+		detail::countOperations(&OperationCounts::copies, n);
 		return Constainer::copy_n(s2, n, s1);
 	}
 
 	/**< This function is called to actually 'move', not copy. */
 	static constexpr pointer move(pointer s1, const_pointer s2, STD::size_t n) {
+		detail::countOperations(&OperationCounts::moves, n);
 		return Constainer::move_n(s2, n, s1);
 	}
 
 	static constexpr pointer assign(pointer s, STD::size_t n, const_reference a) {
+		detail::countOperations(&OperationCounts::copies, n);
 		return Constainer::fill_n(s, n, a);
 	}
 
@@ -37,6 +41,7 @@ struct DefaultCopyTraits {
 
 	template <typename U>
 	static constexpr void assign( reference r, U&& a ) {
+		detail::countOperations(STD::is_lvalue_reference<U>{}? &OperationCounts::copies : &OperationCounts::moves, 1);
 		r = STD::forward<U>(a);
 	}
 };
@@ -101,9 +106,11 @@ protected:
 	constexpr void _createInsertionSpace(const_iterator pos, size_type len) {
 		assert(pos <= end());
 		_verifiedSizeInc(len);
-		if (pos != end()-len)
+		if (pos != end()-len) {
+			detail::countOperations(&OperationCounts::moves, end()-len - pos);
 			// TODO: Implement move_backward that uses CopyTraits::assign
 			Constainer::move_backward(_address(pos), end()-len, end());
+		}
 	}
 
 public:
@@ -0,0 +1,1221 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+#include "../Array.hxx"
+#include "../Math.hxx"
+
+#include <cfloat> // FLT_EVAL_METHOD
+#include <cstdint>
+#include <limits>
+
+#if __cplusplus >= 201703L && defined __has_include
+	#if __has_include(<charconv>)
+		#include <charconv>
+	#endif
+#endif
+
+#ifndef CONSTAINER_HAS_TO_CHARS
+	#if defined __cpp_lib_to_chars && __cpp_lib_to_chars >= 201611L
+		#define CONSTAINER_HAS_TO_CHARS 1
+	#endif
+#endif // defined CONSTAINER_HAS_TO_CHARS
+
+/* Conversions between binary floating point values and decimal digits.
+   Formatting: the shortest round-trip digits of float and double are found with Giulietti's Schubfach
+   algorithm. Digits for a given precision are exact: at runtime they are obtained from STD::to_chars where
+   available, otherwise every digit of the value is computed with big integer arithmetic and rounded.
+   Parsing: inputs are converted with Clinger's fast path or the Eisel-Lemire algorithm; the rare inputs close to
+   a halfway point between two values are decided by comparing big integers. */
+
+namespace Constainer {
+
+namespace detail {
+
+	/**< floor(x / 2^n), also for negative x. */
+	CONSTAINER_PURE_CONST constexpr STD::int64_t floorShift(STD::int64_t x, int n) {
+		return x >= 0? x >> n : ~(~x >> n);
+	}
+
+	/**< floor(log2(10^k)) for |k| <= 1300. */
+	CONSTAINER_PURE_CONST constexpr int floorLog2Pow10(int k) {
+		return floorShift(k * STD::int64_t(1741647), 19);
+	}
+	/**< floor(log10(2^e)) for |e| <= 17000. */
+	CONSTAINER_PURE_CONST constexpr int floorLog10Pow2(int e) {
+		return floorShift(e * STD::int64_t(661971961083), 41);
+	}
+
+	struct UInt128 {
+		STD::uint64_t high = 0, low = 0;
+	};
+
+	CONSTAINER_PURE_CONST constexpr UInt128 multiply64(STD::uint64_t a, STD::uint64_t b) {
+	#ifdef __SIZEOF_INT128__
+		__extension__ typedef unsigned __int128 uint128;
+		auto p = uint128(a) * b;
+		return {STD::uint64_t(p >> 64), STD::uint64_t(p)};
+	#else
+		STD::uint64_t a0 = a & 0xFFFFFFFF, a1 = a >> 32,
+		              b0 = b & 0xFFFFFFFF, b1 = b >> 32;
+		auto p00 = a0*b0, p01 = a0*b1, p10 = a1*b0, p11 = a1*b1;
+		auto middle = (p00 >> 32) + (p01 & 0xFFFFFFFF) + (p10 & 0xFFFFFFFF);
+		return {p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32), middle << 32 | (p00 & 0xFFFFFFFF)};
+	#endif
+	}
+
+	/**< An unsigned integer of at most 32*Limbs bits, for the conversions that need exact arithmetic. */
+	template <STD::size_t Limbs>
+	class BigUnsigned {
+		// Least significant first; limbs at and above _size are zero.
+		Array<STD::uint32_t, Limbs> _limbs{};
+		STD::size_t _size = 0;
+
+		constexpr STD::uint64_t _limb(STD::size_t i) const {return i < _size? _limbs[i] : 0;}
+
+		constexpr void _push(STD::uint64_t limb) {
+			assert( _size < Limbs && "BigUnsigned overflow" );
+			_limbs[_size++] = STD::uint32_t(limb);
+		}
+
+		constexpr void _multiply(STD::uint32_t m) {
+			if (m == 0) {
+				Constainer::fill_n(_limbs.begin(), _size, 0);
+				_size = 0;
+				return;
+			}
+			STD::uint64_t carry = 0;
+			for (auto p = _limbs.data(), last = p + _size; p != last; ++p) {
+				carry += STD::uint64_t(*p) * m;
+				*p = STD::uint32_t(carry);
+				carry >>= 32;
+			}
+			if (carry != 0)
+				_push(carry);
+		}
+
+	public:
+		constexpr BigUnsigned() = default;
+		constexpr explicit BigUnsigned(STD::uint64_t v) {
+			for (; v != 0; v >>= 32)
+				_push(v);
+		}
+
+		constexpr bool is_zero() const {return _size == 0;}
+
+		constexpr STD::size_t bit_length() const {
+			return _size == 0? 0 : 32*_size + 32 - count_leading(_limbs[_size-1]);
+		}
+
+		/**< Bits [pos, pos+64). */
+		constexpr STD::uint64_t bits(STD::size_t pos) const {
+			auto i = pos/32, s = pos%32;
+			auto low = _limb(i) | _limb(i+1) << 32;
+			return s == 0? low : low >> s | _limb(i+2) << (64-s);
+		}
+
+		constexpr void multiply(STD::uint64_t m) {
+			if (m >> 32 == 0)
+				return _multiply(m);
+			auto high = *this;
+			high._multiply(m >> 32);
+			high.shift_left(32);
+			_multiply(STD::uint32_t(m));
+			add(high);
+		}
+		constexpr void multiply_pow5(unsigned n) {
+			for (; n >= 13; n -= 13)
+				_multiply(1220703125);
+			STD::uint32_t m = 1;
+			while (n--)
+				m *= 5;
+			_multiply(m);
+		}
+
+		constexpr void add(BigUnsigned const& rhs) {
+			auto n = STD::max(_size, rhs._size);
+			STD::uint64_t carry = 0;
+			for (STD::size_t i = 0; i != n; ++i) {
+				carry += _limb(i) + rhs._limb(i);
+				_limbs[i] = STD::uint32_t(carry);
+				carry >>= 32;
+			}
+			_size = n;
+			if (carry != 0)
+				_push(carry);
+		}
+		constexpr void add(STD::uint32_t a) {
+			STD::uint64_t carry = a;
+			for (STD::size_t i = 0; carry != 0 && i != _size; ++i) {
+				carry += _limbs[i];
+				_limbs[i] = STD::uint32_t(carry);
+				carry >>= 32;
+			}
+			if (carry != 0)
+				_push(carry);
+		}
+
+		constexpr void shift_left(STD::size_t n) {
+			if (_size == 0)
+				return;
+			auto words = n/32, s = n%32;
+			assert( _size + words <= Limbs && "BigUnsigned overflow" );
+			if (s != 0) {
+				if (auto top = _limbs[_size-1] >> (32-s)) {
+					assert( _size + words < Limbs && "BigUnsigned overflow" );
+					_limbs[_size + words] = top;
+				}
+				for (auto i = _size-1; i != 0; --i)
+					_limbs[i + words] = _limbs[i] << s | _limbs[i-1] >> (32-s);
+				_limbs[words] = _limbs[0] << s;
+			}
+			else
+				for (auto i = _size; i-- != 0;)
+					_limbs[i + words] = _limbs[i];
+			Constainer::fill_n(_limbs.begin(), words, 0);
+			_size += words;
+			if (_size < Limbs && _limbs[_size] != 0)
+				++_size;
+		}
+
+		/**< Subtracts rhs * factor, which must not be greater. */
+		constexpr void subtract(BigUnsigned const& rhs, STD::uint32_t factor = 1) {
+			STD::uint64_t carry = 0;
+			STD::int64_t borrow = 0;
+			for (STD::size_t i = 0; i != _size; ++i) {
+				carry += rhs._limb(i) * factor;
+				borrow += STD::int64_t(_limbs[i]) - STD::int64_t(STD::uint32_t(carry));
+				carry >>= 32;
+				_limbs[i] = STD::uint32_t(borrow);
+				borrow = borrow < 0? -1 : 0;
+			}
+			assert( carry == 0 && borrow == 0 && "BigUnsigned underflow" );
+			while (_size != 0 && _limbs[_size-1] == 0)
+				--_size;
+		}
+
+		/**< Divides by d and returns the remainder. */
+		constexpr STD::uint32_t divide(STD::uint32_t d) {
+			STD::uint64_t rem = 0;
+			for (auto i = _size; i-- != 0;) {
+				rem = rem << 32 | _limbs[i];
+				_limbs[i] = STD::uint32_t(rem / d);
+				rem %= d;
+			}
+			while (_size != 0 && _limbs[_size-1] == 0)
+				--_size;
+			return rem;
+		}
+
+		/**< Compares a + b with c without computing the sum. */
+		friend constexpr int compareSum(BigUnsigned const& a, BigUnsigned const& b, BigUnsigned const& c) {
+			auto n = STD::max(STD::max(a._size, b._size), c._size);
+			STD::uint64_t carry = 0;
+			int result = 0;
+			for (STD::size_t i = 0; i != n; ++i) {
+				carry += a._limb(i) + b._limb(i);
+				auto limb = STD::uint32_t(carry), other = STD::uint32_t(c._limb(i));
+				if (limb != other)
+					result = limb < other? -1 : 1;
+				carry >>= 32;
+			}
+			return carry != 0? 1 : result;
+		}
+
+		friend constexpr int compare(BigUnsigned const& lhs, BigUnsigned const& rhs) {
+			if (lhs._size != rhs._size)
+				return lhs._size < rhs._size? -1 : 1;
+			for (auto i = lhs._size; i-- != 0;)
+				if (lhs._limbs[i] != rhs._limbs[i])
+					return lhs._limbs[i] < rhs._limbs[i]? -1 : 1;
+			return 0;
+		}
+	};
+
+	/**< Table of the 128 most significant bits of 10^k, rounded down: 10^k is approximately
+	     pow10Significand(k) * 2^(floorLog2Pow10(k) - 127). This is exact for 0 <= k <= 55. */
+	struct Pow10Range {
+		static constexpr int min = -342, max = 326;
+	};
+	using Pow10TableType = Array<UInt128, Pow10Range::max - Pow10Range::min + 1>;
+
+	constexpr Pow10TableType generatePow10Table() {
+		constexpr int min = Pow10Range::min, max = Pow10Range::max;
+		Pow10TableType table{};
+		BigUnsigned<36> power(1);
+		for (int k = 0; k <= max; ++k) {
+			auto length = power.bit_length();
+			assert( int(length) == floorLog2Pow10(k) + 1 );
+			if (length >= 128)
+				table[k - min] = {power.bits(length-64), power.bits(length-128)};
+			else {
+				auto shifted = power;
+				shifted.shift_left(128 - length);
+				table[k - min] = {shifted.bits(64), shifted.bits(0)};
+			}
+			power.multiply(10);
+		}
+		// floor(2^1280 / 10^k)
+		BigUnsigned<42> reciprocal(1);
+		reciprocal.shift_left(1280);
+		for (int k = 1; k <= -min; ++k) {
+			reciprocal.divide(10);
+			// floor(2^(l+127) / 10^k), where l is the bit length of 10^k, has exactly 128 bits.
+			auto shift = 1280 - (floorLog2Pow10(k) + 1) - 127;
+			table[-k - min] = {reciprocal.bits(shift + 64), reciprocal.bits(shift)};
+			assert( int(reciprocal.bit_length()) == shift + 128 );
+		}
+		return table;
+	}
+
+	template <typename = void>
+	struct Pow10Table {
+		static constexpr Pow10TableType significands = generatePow10Table();
+	};
+	template <typename T>
+	constexpr Pow10TableType Pow10Table<T>::significands;
+
+	CONSTAINER_PURE_CONST constexpr UInt128 pow10Significand(int k) {
+		return Pow10Table<>::significands[k - Pow10Range::min];
+	}
+
+	template <typename Float>
+	struct FloatInfo {
+		using limits = STD::numeric_limits<Float>;
+		static_assert( limits::radix == 2 && limits::digits <= 64, "Unsupported floating point format" );
+
+		/**< Bits of the significand, including the leading one */
+		static constexpr int digits = limits::digits;
+		/**< The exponents of the least significant bit of subnormal and of the largest finite values. */
+		static constexpr int min_exponent = limits::min_exponent - digits,
+		                     max_exponent = limits::max_exponent - digits;
+		/**< Whether Float is an IEEE 754 interchange format whose bits can be inspected directly. */
+		static constexpr bool interchange = limits::is_iec559
+		                                 && ((digits == 24 && sizeof(Float) == 4) || (digits == 53 && sizeof(Float) == 8));
+		using bits_type = STD::conditional_t<sizeof(Float) == 4, STD::uint32_t, STD::uint64_t>;
+	};
+
+	template <typename Float>
+	using canBitCast = STD::integral_constant<bool, FloatInfo<Float>::interchange
+	#ifdef CONSTAINER_HAS_BUILTIN_BIT_CAST
+		&& true
+	#else
+		&& false
+	#endif
+	>;
+
+	/**< The non-negative, finite value significand * 2^exponent. The significand has exactly FloatInfo<>::digits bits
+	     unless the value is subnormal or zero, in which case the exponent is FloatInfo<>::min_exponent. */
+	struct BinaryFloat {
+		STD::uint64_t significand = 0;
+		int exponent = 0;
+	};
+
+	template <typename Float>
+	CONSTAINER_PURE_CONST constexpr Float powerOfTwo(int n) {
+		Float r = 1;
+		while (n-- > 0)
+			r *= 2;
+		return r;
+	}
+
+	#ifdef CONSTAINER_HAS_BUILTIN_BIT_CAST
+	template <typename Float>
+	constexpr BinaryFloat decompose(Float x, STD::true_type) {
+		using info = FloatInfo<Float>;
+		using bits_type = typename info::bits_type;
+		auto bits = __builtin_bit_cast(bits_type, x);
+		constexpr auto hidden = bits_type(1) << (info::digits-1);
+		int biased = bits >> (info::digits-1) & ((1 << (sizeof(Float)*8 - info::digits)) - 1);
+		if (biased == 0)
+			return {bits & (hidden-1), info::min_exponent};
+		return {(bits & (hidden-1)) | hidden, biased - 1 + info::min_exponent};
+	}
+	template <typename Float>
+	constexpr Float compose(BinaryFloat b, STD::true_type) {
+		using info = FloatInfo<Float>;
+		using bits_type = typename info::bits_type;
+		if (b.exponent > info::max_exponent)
+			return STD::numeric_limits<Float>::infinity();
+		// The leading one of normal significands increments the biased exponent.
+		return __builtin_bit_cast(Float, bits_type((bits_type(b.exponent - info::min_exponent) << (info::digits-1)) + b.significand));
+	}
+	#endif
+
+	/**< Obtains the significand by scaling with powers of two, which is exact. */
+	template <typename Float>
+	constexpr BinaryFloat decompose(Float x, STD::false_type) {
+		using info = FloatInfo<Float>;
+		if (x == 0)
+			return {0, info::min_exponent};
+		constexpr Float scale = 4294967296.0;
+		auto const top = powerOfTwo<Float>(info::digits);
+		int exponent = 0;
+		while (x >= top * scale) {x /= scale; exponent += 32;}
+		while (x * scale < top)  {x *= scale; exponent -= 32;}
+		while (x >= top)         {x /= 2; ++exponent;}
+		while (x * 2 < top)      {x *= 2; --exponent;}
+		STD::uint64_t significand = x;
+		if (exponent < info::min_exponent) {
+			significand >>= info::min_exponent - exponent;
+			exponent = info::min_exponent;
+		}
+		return {significand, exponent};
+	}
+	template <typename Float>
+	constexpr Float compose(BinaryFloat b, STD::false_type) {
+		using info = FloatInfo<Float>;
+		if (b.exponent > info::max_exponent)
+			return STD::numeric_limits<Float>::infinity();
+		constexpr Float scale = 4294967296.0;
+		Float x = b.significand;
+		int e = b.exponent;
+		for (; e >= 32;  e -= 32) x *= scale;
+		for (; e <= -32; e += 32) x /= scale;
+		for (; e > 0; --e) x *= 2;
+		for (; e < 0; ++e) x /= 2;
+		return x;
+	}
+
+	/**< Splits the finite, non-negative x into significand and exponent. */
+	template <typename Float>
+	constexpr BinaryFloat decompose(Float x) {
+		return decompose(x, canBitCast<Float>{});
+	}
+	/**< The inverse of decompose. Exponents above the range yield infinity. */
+	template <typename Float>
+	constexpr Float compose(BinaryFloat b) {
+		return compose<Float>(b, canBitCast<Float>{});
+	}
+
+	/**< Decimal digit sources describe a positive value d0.d1d2... * 10^exponent() by its significant digits.
+	     operator[] yields d_i, and zero beyond size(), which excludes trailing zeroes. Zero has no digits. */
+
+	/**< At most Capacity digits, stored directly. */
+	template <int Capacity>
+	class DecimalDigits {
+		Array<char, Capacity> _digits{};
+		int _size = 0, _exponent = 0;
+
+	public:
+		constexpr DecimalDigits() = default;
+		/**< The digits of significand * 10^exponent. */
+		constexpr DecimalDigits(STD::uint64_t significand, int exponent) {
+			if (significand == 0)
+				return;
+			while (significand % 10 == 0) {
+				significand /= 10;
+				++exponent;
+			}
+			for (auto s = significand; s != 0; s /= 10)
+				++_size;
+			_exponent = exponent + _size - 1;
+			for (auto i = _size; i-- != 0; significand /= 10)
+				_digits[i] = significand % 10;
+		}
+		/**< The characters [digits, digits+count) with the given exponent. */
+		constexpr DecimalDigits(char const* digits, int count, int exponent) : _size(count), _exponent(exponent) {
+			for (int i = 0; i != count; ++i)
+				_digits[i] = digits[i] - '0';
+			while (_size != 0 && _digits[_size-1] == 0)
+				--_size;
+		}
+		/**< The first count digits of source. */
+		template <typename Digits>
+		constexpr DecimalDigits(Digits const& source, int count) : _exponent(source.exponent()) {
+			_size = STD::min(source.size(), count);
+			for (int i = 0; i != _size; ++i)
+				_digits[i] = source[i];
+			while (_size != 0 && _digits[_size-1] == 0)
+				--_size;
+		}
+
+		constexpr int size() const {return _size;}
+		constexpr int exponent() const {return _exponent;}
+		constexpr unsigned operator[](int i) const {return i < _size? _digits[i] : 0;}
+	};
+
+	/**< All digits of a binary value, computed with big integer arithmetic. */
+	template <typename Float>
+	class ExactDecimal {
+		using _info = FloatInfo<Float>;
+		// significand * 2^exponent, or significand * 5^-exponent for negative exponents
+		static constexpr int _bits = _info::digits + (_info::max_exponent > -_info::min_exponent * 2322 / 1000 + 1?
+		                                              _info::max_exponent : -_info::min_exponent * 2322 / 1000 + 1);
+		static constexpr int _capacity = _bits * 30103 / 100000 + 2;
+
+		// The digits occupy [_first, _capacity).
+		Array<char, _capacity> _digits{};
+		int _first = _capacity, _size = 0, _exponent = 0;
+
+	public:
+		constexpr explicit ExactDecimal(BinaryFloat b) {
+			if (b.significand == 0)
+				return;
+			BigUnsigned<_bits/32 + 2> n(b.significand);
+			if (b.exponent >= 0)
+				n.shift_left(b.exponent);
+			else {
+				n.multiply_pow5(-b.exponent);
+				_exponent = b.exponent;
+			}
+			// Nine digits at a time, from the least significant one
+			while (!n.is_zero()) {
+				auto chunk = n.divide(1000000000);
+				for (int i = 0; i != 9 && (chunk != 0 || !n.is_zero()); ++i, chunk /= 10)
+					_digits[--_first] = chunk % 10;
+			}
+			_size = _capacity - _first;
+			_exponent += _size - 1;
+			while (_digits[_first + _size-1] == 0)
+				--_size;
+		}
+
+		constexpr int size() const {return _size;}
+		constexpr int exponent() const {return _exponent;}
+		constexpr unsigned operator[](int i) const {return i < _size? _digits[_first + i] : 0;}
+	};
+
+	/**< A decimal number in text form, d.ddde+dd or ddd.ddd, such as the output of STD::to_chars. */
+	class TextDecimal {
+		char const* _text;
+		int _point = 0, _first = 0, _size = 0, _exponent = 0;
+
+		constexpr int _index(int i) const {return _first + i + (_first < _point && _first + i >= _point);}
+
+	public:
+		constexpr TextDecimal(char const* first, char const* last) : _text(first) {
+			int length = last - first, mantissa = 0;
+			while (mantissa != length && first[mantissa] != 'e' && first[mantissa] != 'E')
+				++mantissa;
+			_point = 0;
+			while (_point != mantissa && first[_point] != '.')
+				++_point;
+			_first = 0;
+			while (_first != mantissa && (first[_first] == '0' || first[_first] == '.'))
+				++_first;
+			if (_first == mantissa)
+				return;
+			int last_digit = mantissa;
+			while (first[last_digit-1] == '0' || first[last_digit-1] == '.')
+				--last_digit;
+			_size = last_digit - _first - (_first < _point && _point < last_digit);
+			_exponent = _point - _first - (_first < _point);
+			if (mantissa != length) {
+				int exponent = 0;
+				bool negative = first[mantissa+1] == '-';
+				for (int i = mantissa + 1 + (first[mantissa+1] == '-' || first[mantissa+1] == '+'); i != length; ++i)
+					exponent = exponent*10 + (first[i] - '0');
+				_exponent += negative? -exponent : exponent;
+			}
+		}
+
+		constexpr int size() const {return _size;}
+		constexpr int exponent() const {return _exponent;}
+		constexpr unsigned operator[](int i) const {return i < _size? _text[_index(i)] - '0' : 0;}
+	};
+
+	/**< Rounds a digit source to count significant digits, i.e. to a multiple of 10^(exponent - count + 1),
+	     with ties to even. The source must outlive the rounded view. */
+	template <typename Digits>
+	class RoundedDecimal {
+		Digits const& _digits;
+		int _size, _exponent;
+		// If nonnegative, the position of the digit that is incremented; all following ones are dropped.
+		int _carry = -1;
+		// Whether all kept digits carried over, which yields a single one.
+		bool _one = false;
+		bool _up = false;
+
+	public:
+		constexpr RoundedDecimal(Digits const& digits, int count)
+			: _digits(digits), _size(digits.size()), _exponent(digits.exponent()) {
+			if (count >= _size)
+				return;
+			if (count >= 0) {
+				auto next = digits[count];
+				_up = next > 5 || (next == 5 && (count+1 < _size || (count != 0 && digits[count-1] % 2 != 0)));
+			}
+			if (!_up) {
+				_size = STD::max(count, 0);
+				while (_size != 0 && digits[_size-1] == 0)
+					--_size;
+				if (_size == 0)
+					_exponent = 0;
+				return;
+			}
+			_carry = count-1;
+			while (_carry >= 0 && digits[_carry] == 9)
+				--_carry;
+			if (_carry < 0) {
+				_one = true;
+				_size = 1;
+				++_exponent;
+			}
+			else
+				_size = _carry+1;
+		}
+
+		/**< Whether the digits were rounded away from zero. */
+		constexpr bool up() const {return _up;}
+
+		constexpr int size() const {return _size;}
+		constexpr int exponent() const {return _exponent;}
+		constexpr unsigned operator[](int i) const {
+			if (i >= _size)
+				return 0;
+			if (_one)
+				return 1;
+			return _digits[i] + (i == _carry);
+		}
+	};
+
+	/**< The conversions of printf, and the shortest representation. */
+	enum class FloatStyle {scientific, fixed, general, shortest};
+
+	template <typename Tokens>
+	CONSTAINER_PURE_CONST constexpr STD::remove_const_t<decltype(Tokens::zero)> digitChar(unsigned digit) {
+		return Tokens::zero + digit;
+	}
+
+	template <typename Tokens, typename OutputIt>
+	constexpr OutputIt writeExponent(OutputIt out, int exponent, bool upper) {
+		*out++ = upper? Tokens::upperExp : Tokens::lowerExp;
+		*out++ = exponent < 0? Tokens::minus : Tokens::plus;
+		unsigned e = exponent < 0? -exponent : exponent;
+		unsigned power = 10;
+		while (power * 10 <= e)
+			power *= 10;
+		for (; power != 0; power /= 10)
+			*out++ = digitChar<Tokens>(e / power % 10);
+		return out;
+	}
+
+	/**< Writes d.ddd...e+xx with precision digits after the point. The digits must not need rounding. */
+	template <typename Tokens, typename OutputIt, typename Digits>
+	constexpr OutputIt writeScientific(OutputIt out, Digits const& digits, int precision, bool alternative, bool upper) {
+		*out++ = digitChar<Tokens>(digits[0]);
+		if (precision != 0 || alternative)
+			*out++ = Tokens::decimalPoint;
+		for (int i = 1; i <= precision; ++i)
+			*out++ = digitChar<Tokens>(digits[i]);
+		return writeExponent<Tokens>(out, digits.size() == 0? 0 : digits.exponent(), upper);
+	}
+
+	/**< Writes ddd.ddd with precision digits after the point. The digits must not need rounding. */
+	template <typename Tokens, typename OutputIt, typename Digits>
+	constexpr OutputIt writeFixed(OutputIt out, Digits const& digits, int precision, bool alternative) {
+		int exponent = digits.size() == 0? 0 : digits.exponent();
+		if (exponent < 0)
+			*out++ = digitChar<Tokens>(0);
+		for (int i = 0; i <= exponent; ++i)
+			*out++ = digitChar<Tokens>(digits[i]);
+		if (precision != 0 || alternative)
+			*out++ = Tokens::decimalPoint;
+		for (int i = exponent+1; i <= exponent + precision; ++i)
+			*out++ = digitChar<Tokens>(i < 0? 0 : digits[i]);
+		return out;
+	}
+
+	/**< Writes digits in the given printf style, rounding them as necessary. */
+	template <typename Tokens, typename OutputIt, typename Digits>
+	constexpr OutputIt writeRounded(OutputIt out, Digits const& digits, FloatStyle style, int precision,
+	                                bool alternative, bool upper) {
+		using rounded = RoundedDecimal<Digits>;
+		if (style == FloatStyle::scientific)
+			return writeScientific<Tokens>(out, rounded(digits, precision+1), precision, alternative, upper);
+		if (style == FloatStyle::fixed)
+			return writeFixed<Tokens>(out, rounded(digits, digits.exponent() + 1 + precision), precision, alternative);
+
+		// %g: P significant digits, in fixed notation if the exponent X satisfies P > X >= -4.
+		if (precision == 0)
+			precision = 1;
+		rounded r(digits, precision);
+		int exponent = r.size() == 0? 0 : r.exponent();
+		if (exponent < precision && exponent >= -4) {
+			precision -= exponent+1;
+			if (!alternative)
+				precision = STD::min(precision, STD::max(r.size()-1 - exponent, 0));
+			return writeFixed<Tokens>(out, r, precision, alternative);
+		}
+		precision -= 1;
+		if (!alternative)
+			precision = STD::min(precision, STD::max(r.size()-1, 0));
+		return writeScientific<Tokens>(out, r, precision, alternative, upper);
+	}
+
+	/**< Writes the shortest digits of x in whichever of fixed or scientific notation is shorter, preferring the
+	     former. Like STD::to_chars, integers in fixed notation are written with all of their digits. */
+	template <typename Tokens, typename OutputIt, typename Digits, typename Float>
+	constexpr OutputIt writeShortest(OutputIt out, Digits const& digits, Float x) {
+		int size = digits.size(), exponent = size == 0? 0 : digits.exponent();
+		int magnitude = exponent < 0? -exponent : exponent;
+		int scientific = size + (size > 1) + 2 + (magnitude < 100? 2 : magnitude < 1000? 3 : 4),
+		    fixed = exponent < 0? size + 1 - exponent : STD::max(size, exponent+1) + (size > exponent+1);
+		if (fixed <= scientific && size != 0 && size-1 < exponent)
+			return writeFixed<Tokens>(out, ExactDecimal<Float>(decompose(x)), 0, false);
+		if (fixed <= scientific)
+			return writeFixed<Tokens>(out, digits, STD::max(size-1 - exponent, 0), false);
+		return writeScientific<Tokens>(out, digits, size-1, false, false);
+	}
+
+	/**< Rounds g * cp / 2^128 to odd, with g being a ceiled table entry. */
+	CONSTAINER_PURE_CONST constexpr STD::uint64_t roundToOdd(UInt128 g, STD::uint64_t cp) {
+		auto x = multiply64(g.low, cp), y = multiply64(g.high, cp);
+		auto middle = y.low + x.high;
+		auto high = y.high + (middle < x.high);
+		return high | (middle > 1);
+	}
+
+	/**< Whether shortestDecimal supports Float: Schubfach needs more than twice the significand's bits from the
+	     powers of ten, which the table provides for up to 53 bits. */
+	template <typename Float>
+	using hasSchubfach = STD::integral_constant<bool, FloatInfo<Float>::digits <= 53
+	                                               && STD::numeric_limits<Float>::max_exponent10 < Pow10Range::max
+	                                               && -STD::numeric_limits<Float>::min_exponent10 + 20 < -Pow10Range::min>;
+
+	struct DecimalFloat {
+		STD::uint64_t significand;
+		int exponent;
+	};
+
+	/**< Giulietti's Schubfach algorithm: the shortest decimal significand * 10^exponent that rounds to the positive
+	     value b, and the one closest to b if there are several. */
+	template <typename Float>
+	constexpr DecimalFloat shortestDecimal(BinaryFloat b) {
+		using info = FloatInfo<Float>;
+		constexpr auto hidden = STD::uint64_t(1) << (info::digits-1);
+		auto c = b.significand;
+		int q = b.exponent;
+		// Small integers are their own shortest representation.
+		if (c >= hidden && q <= 0 && -q < info::digits && (c & ((STD::uint64_t(1) << -q) - 1)) == 0)
+			return {c >> -q, 0};
+
+		bool even = c % 2 == 0;
+		// At the bottom of a binade, the next smaller value is closer than the next larger one.
+		bool lower_closer = c == hidden && q > info::min_exponent;
+		// The value and the bounds of its rounding interval, times four
+		auto cbl = 4*c - 2 + lower_closer, cb = 4*c, cbr = 4*c + 2;
+
+		int k = floorShift(q * STD::int64_t(1262611) - (lower_closer? 524031 : 0), 22);
+		int h = q + floorLog2Pow10(-k) + 1;
+		auto g = pow10Significand(-k);
+		if (-k < 0 || -k > 55)
+			g.high += ++g.low == 0;
+
+		auto vbl = roundToOdd(g, cbl << h), vb = roundToOdd(g, cb << h), vbr = roundToOdd(g, cbr << h);
+		auto lower = vbl + !even, upper = vbr - !even;
+
+		auto s = vb / 4;
+		if (s >= 10) {
+			auto sp = s / 10;
+			bool up_inside = lower <= 40*sp, wp_inside = 40*sp + 40 <= upper;
+			if (up_inside != wp_inside)
+				return {sp + wp_inside, k+1};
+		}
+		bool u_inside = lower <= 4*s, w_inside = 4*s + 4 <= upper;
+		if (u_inside != w_inside)
+			return {s + w_inside, k};
+		auto mid = 4*s + 2;
+		return {s + (vb > mid || (vb == mid && s % 2 != 0)), k};
+	}
+
+	/**< The state of a scan over the digits of a decimal number. */
+	template <typename Accumulator>
+	struct DigitScan {
+		/**< The leading significant digits */
+		Accumulator digits{};
+		/**< The decimal exponent of the last digit in digits */
+		int exponent = 0;
+		/**< The number of significant digits, including those that did not fit */
+		int count = 0;
+		/**< Whether a digit, significant or not, was read */
+		bool read = false;
+		/**< Whether a digit that did not fit is nonzero */
+		bool truncated = false;
+	};
+
+	constexpr void appendDigit(STD::uint64_t& acc, unsigned digit) {
+		acc = acc*10 + digit;
+	}
+	template <STD::size_t Limbs>
+	constexpr void appendDigit(BigUnsigned<Limbs>& acc, unsigned digit) {
+		acc.multiply(10);
+		acc.add(STD::uint32_t(digit));
+	}
+
+	/**< Reads digits with at most one decimal point, keeping the first max_digits significant ones. */
+	template <typename Accumulator, typename InputIt>
+	constexpr InputIt scanDigits(InputIt first, InputIt last, DigitScan<Accumulator>& scan, int max_digits) {
+		bool point = false;
+		for (; first != last; ++first) {
+			if (*first == '.') {
+				if (point)
+					break;
+				point = true;
+				continue;
+			}
+			unsigned digit = *first - '0';
+			if (digit > 9)
+				break;
+			scan.read = true;
+			if (scan.count == 0 && digit == 0) {
+				scan.exponent -= point;
+				continue;
+			}
+			if (scan.count < max_digits) {
+				appendDigit(scan.digits, digit);
+				scan.exponent -= point;
+			}
+			else {
+				scan.truncated |= digit != 0;
+				scan.exponent += !point;
+			}
+			++scan.count;
+		}
+		return first;
+	}
+
+	/**< Exact powers of ten: 10^k = 5^k 2^k is exact as long as 5^k fits into the significand. */
+	template <typename Float>
+	constexpr int maxExactPow10() {
+		constexpr int digits = FloatInfo<Float>::digits;
+		constexpr auto max_significand = ~STD::uint64_t(0) >> (64 - digits);
+		int k = 0;
+		for (STD::uint64_t p = 1; p <= max_significand / 5; p *= 5)
+			++k;
+		return k;
+	}
+	template <typename Float>
+	constexpr Array<Float, maxExactPow10<Float>()+1> generateExactPow10() {
+		Array<Float, maxExactPow10<Float>()+1> powers{};
+		Float p = 1;
+		for (auto& x : powers) {
+			x = p;
+			p *= 10;
+		}
+		return powers;
+	}
+	template <typename Float>
+	struct ExactPow10 {
+		static constexpr int max = maxExactPow10<Float>();
+		static constexpr Array<Float, max+1> values = generateExactPow10<Float>();
+	};
+	template <typename Float>
+	constexpr Array<Float, ExactPow10<Float>::max+1> ExactPow10<Float>::values;
+
+	/**< Bits [pos, pos+64) of the 192-bit number p2:p1:p0. */
+	CONSTAINER_PURE_CONST constexpr STD::uint64_t bitsOf192(STD::uint64_t p2, STD::uint64_t p1, STD::uint64_t p0, int pos) {
+		STD::uint64_t words[] {p0, p1, p2, 0};
+		int i = pos/64, s = pos%64;
+		if (i >= 3)
+			return 0;
+		return s == 0? words[i] : words[i] >> s | words[i+1] << (64-s);
+	}
+	/**< The low n bits of high:low, for 0 < n <= 128. */
+	CONSTAINER_PURE_CONST constexpr UInt128 lowBits(STD::uint64_t high, STD::uint64_t low, int n) {
+		if (n <= 64)
+			return {0, n == 64? low : low & ((STD::uint64_t(1) << n) - 1)};
+		return {n == 128? high : high & ((STD::uint64_t(1) << (n-64)) - 1), low};
+	}
+
+	/**< The Eisel-Lemire algorithm: rounds w * 10^q to the nearest binary value by multiplying w with the 128-bit
+	     significand of 10^q. The product is too small by less than 2^64 units, so the rounding direction is decided
+	     unless the discarded bits are just below a halfway point. Returns false in that case, with b being the
+	     value rounded down. q must be within the table. */
+	template <typename Float>
+	constexpr bool eiselLemire(STD::uint64_t w, int q, BinaryFloat& b) {
+		using info = FloatInfo<Float>;
+		constexpr int P = info::digits;
+		int shift = count_leading(w);
+		w <<= shift;
+		auto power = pow10Significand(q);
+		auto low = multiply64(w, power.low), high = multiply64(w, power.high);
+		STD::uint64_t p0 = low.low, p1 = high.low + low.high, p2 = high.high + (p1 < low.high);
+
+		// The exponents of the product's unit and of the result's least significant bit
+		int unit = floorLog2Pow10(q) - 127 - shift,
+		    lsb = 190 + int(p2 >> 63) + unit - (P-1);
+		if (lsb < info::min_exponent)
+			lsb = info::min_exponent;
+		// The number of discarded bits, at least 127
+		int s = lsb - unit;
+		if (s > 192) {
+			b = {0, info::min_exponent};
+			return true;
+		}
+		// The product's leading bit is bit 190 or 191, so these are exactly the kept bits.
+		auto significand = bitsOf192(p2, p1, p0, s);
+		bool round = bitsOf192(p2, p1, p0, s-1) & 1;
+		// The discarded bits below the rounding bit, except for p0
+		auto rest = lowBits(p2, p1, s-65);
+		bool up = round;
+		if (q >= 0 && q <= 55)
+			up = round && (p0 != 0 || rest.high != 0 || rest.low != 0 || significand % 2 != 0);
+		else {
+			auto ones = lowBits(~STD::uint64_t(0), ~STD::uint64_t(0), s-65);
+			if (!round && p0 != 0 && rest.high == ones.high && rest.low == ones.low) {
+				b = {significand, lsb};
+				return false;
+			}
+		}
+		if (up) {
+			if (significand == (P == 64? ~STD::uint64_t(0) : (STD::uint64_t(1) << P) - 1)) {
+				significand = STD::uint64_t(1) << (P-1);
+				++lsb;
+			}
+			else
+				++significand;
+		}
+		b = {significand, lsb};
+		return true;
+	}
+
+	/**< Bounds for parsing decimal numbers exactly. */
+	template <typename Float>
+	struct ExactParsing {
+		using info = FloatInfo<Float>;
+		/**< Halfway points between adjacent values have at most this many significant digits. Any further digits
+		     of the input only matter by being nonzero. */
+		static constexpr int max_digits = STD::max(((info::digits+1) * 30103 + (1-info::min_exponent) * 69898) / 100000,
+		                                           (info::max_exponent + info::digits+1) * 30103 / 100000) + 4;
+		static constexpr int max_bits = STD::max(STD::max(max_digits * 3322 / 1000,
+		                                                  info::digits + 2 + (max_digits - floorLog10Pow2(info::min_exponent-1) + 2) * 2322 / 1000),
+		                                         STD::numeric_limits<Float>::max_exponent + 4);
+		using big = BigUnsigned<max_bits/32 + 3>;
+	};
+
+	/**< The sign of a * 2^ea - b * 2^eb. */
+	template <STD::size_t Limbs>
+	constexpr int compareScaled(BigUnsigned<Limbs> a, int ea, BigUnsigned<Limbs> b, int eb) {
+		if (a.is_zero() || b.is_zero())
+			return !a.is_zero() - !b.is_zero();
+		// Compare the magnitudes first to keep the shifts small.
+		auto la = int(a.bit_length()) + ea, lb = int(b.bit_length()) + eb;
+		if (la != lb)
+			return la < lb? -1 : 1;
+		if (ea > eb)
+			a.shift_left(ea - eb);
+		else
+			b.shift_left(eb - ea);
+		return compare(a, b);
+	}
+
+	/**< The sign of digits * 10^q, plus a nonzero sticky digit, minus the halfway point above m * 2^e. For positive
+	     q, digits is premultiplied with 5^q, otherwise pow5 is 5^-q. */
+	template <typename Big>
+	constexpr int compareHalfway(Big const& digits, int q, bool sticky, Big const& pow5, STD::uint64_t m, int e) {
+		auto halfway = pow5;
+		halfway.multiply(m);
+		halfway.shift_left(1);
+		halfway.add(pow5);
+		int c = compareScaled(digits, q, halfway, e-1);
+		return c == 0 && sticky? 1 : c;
+	}
+
+	/**< Rounds the decimal number in [first, last), times 10^exponent, correctly: starting from the candidate b, the
+	     decimal is compared with the halfway points to the neighbouring values until it lies between them. */
+	template <typename Float, typename ForwardIt>
+	constexpr BinaryFloat roundCorrectly(ForwardIt first, ForwardIt last, int exponent, BinaryFloat b) {
+		using info = FloatInfo<Float>;
+		using big = typename ExactParsing<Float>::big;
+		constexpr auto hidden = STD::uint64_t(1) << (info::digits-1);
+		constexpr auto max_significand = hidden - 1 + hidden;
+
+		// The decimal is digits * 5^q * 2^q. The power of five goes to the side where q has its sign.
+		DigitScan<big> scan;
+		scanDigits(first, last, scan, ExactParsing<Float>::max_digits);
+		int q = scan.exponent + exponent;
+		big pow5(1);
+		if (q > 0)
+			scan.digits.multiply_pow5(q);
+		else
+			pow5.multiply_pow5(-q);
+		for (;;) {
+			int c = compareHalfway(scan.digits, q, scan.truncated, pow5, b.significand, b.exponent);
+			if (c >= 0) {
+				// Ties go to the even neighbour.
+				if (c == 0 && b.significand % 2 == 0)
+					return b;
+				if (b.significand == max_significand)
+					b = {hidden, b.exponent+1};
+				else
+					++b.significand;
+				if (c == 0 || b.exponent > info::max_exponent)
+					return b;
+				continue;
+			}
+			if (b.significand == 0)
+				return b;
+			auto prev = b.significand == hidden && b.exponent > info::min_exponent?
+			                BinaryFloat{max_significand, b.exponent-1} : BinaryFloat{b.significand-1, b.exponent};
+			c = compareHalfway(scan.digits, q, scan.truncated, pow5, prev.significand, prev.exponent);
+			if (c > 0 || (c == 0 && prev.significand % 2 != 0))
+				return b;
+			b = prev;
+			if (c == 0)
+				return b;
+		}
+	}
+
+	/**< Converts a scanned decimal, times 10^exponent, to the nearest Float. [first, last) are the scanned characters,
+	     which are read again in the rare cases that need all digits. */
+	template <typename Float, typename ForwardIt>
+	constexpr Float decimalToFloat(ForwardIt first, ForwardIt last, DigitScan<STD::uint64_t> const& scan, int exponent) {
+		using info = FloatInfo<Float>;
+		using limits = STD::numeric_limits<Float>;
+		if (scan.count == 0)
+			return 0;
+		auto q = STD::int64_t(scan.exponent) + exponent;
+		// The decimal exponent of the leading digit
+		auto lead = q + STD::min(scan.count, 19) - 1;
+		if (lead > limits::max_exponent10)
+			return limits::infinity();
+		// The value is below 10^(lead+1), which does not exceed half the smallest subnormal value.
+		if (lead < floorLog10Pow2(info::min_exponent-1))
+			return 0;
+
+		// Clinger's fast path: both w and 10^|q| are exact, so a single rounding yields the result. Not applicable if
+		// intermediate results have excess precision.
+		constexpr bool exact_arithmetic =
+		#if defined FLT_EVAL_METHOD && FLT_EVAL_METHOD == 0
+			true;
+		#else
+			false;
+		#endif
+		auto w = scan.digits;
+		if ((exact_arithmetic || isConstantEvaluated()) && !scan.truncated
+		 && w <= ~STD::uint64_t(0) >> (64 - info::digits) && q >= -ExactPow10<Float>::max && q <= ExactPow10<Float>::max)
+			return q < 0? Float(w) / ExactPow10<Float>::values[-q] : Float(w) * ExactPow10<Float>::values[q];
+
+		BinaryFloat b;
+		bool decided = false;
+		if (q >= Pow10Range::min && q <= Pow10Range::max) {
+			decided = eiselLemire<Float>(w, q, b);
+			// The digits that did not fit lie between w and w+1.
+			if (decided && scan.truncated) {
+				BinaryFloat upper;
+				decided = eiselLemire<Float>(w+1, q, upper)
+				       && upper.significand == b.significand && upper.exponent == b.exponent;
+			}
+		}
+		else {
+			// Only formats with a wider exponent range than binary64 get here. The candidate is off by a few units.
+			Float scaled = Float(w) * pow(Float(10), int(q/2)), rest = pow(Float(10), int(q - q/2));
+			b = decompose(scaled < limits::max() / rest? scaled * rest : limits::max());
+		}
+		if (!decided)
+			b = roundCorrectly<Float>(first, last, exponent, b);
+		return compose<Float>(b);
+	}
+
+	/**< Whether r + m reaches s, or exceeds it if not inclusive. */
+	template <typename Big>
+	constexpr bool reaches(Big const& r, Big const& m, Big const& s, bool inclusive) {
+		auto cmp = compareSum(r, m, s);
+		return inclusive? cmp >= 0 : cmp > 0;
+	}
+
+	/**< Burger and Dybvig's free-format algorithm: generates the digits of the positive x one at a time with exact
+	     arithmetic, and stops at the first digit after which either bound of the rounding interval is within reach.
+	     Serves the formats that Schubfach does not support; the big integers are scaled by a power of ten only once. */
+	template <typename Float>
+	constexpr DecimalDigits<STD::numeric_limits<Float>::max_digits10 + 1> shortestByGeneration(Float x) {
+		using info = FloatInfo<Float>;
+		using big = BigUnsigned<(info::digits + (info::max_exponent > -info::min_exponent? info::max_exponent
+		                                                                                  : -info::min_exponent) + 8)/32 + 2>;
+		constexpr auto hidden = STD::uint64_t(1) << (info::digits-1);
+		auto b = decompose(x);
+		auto c = b.significand;
+		int q = b.exponent;
+		bool even = c % 2 == 0;
+		// At the bottom of a binade, the next smaller value is closer than the next larger one.
+		bool lower_closer = c == hidden && q > info::min_exponent;
+		unsigned shift = 1 + lower_closer;
+
+		// x = r/s, and the rounding interval is (x - m_low/s, x + m_high/s), inclusive if the significand is even.
+		// All four are scaled so that the first digit is at 10^(k-1), starting with an estimate of k that is too low.
+		// Powers of two common to r and s are left out.
+		int k = floorShift((q + 63 - int(count_leading(c))) * STD::int64_t(1262611), 22) - 1;
+		big s(1), m_low(1);
+		if (k >= 0) {
+			// q > k unless both are small
+			s.multiply_pow5(k);
+			if (q >= k)
+				m_low.shift_left(q - k);
+			else
+				s.shift_left(k - q);
+		}
+		else {
+			// -q > -k
+			m_low.multiply_pow5(-k);
+			s.shift_left(k - q);
+		}
+		s.shift_left(shift);
+		auto r = m_low, m_high = m_low;
+		r.multiply(c);
+		r.shift_left(shift);
+		m_high.shift_left(shift-1);
+
+		while (reaches(r, m_high, s, even)) {
+			s.multiply(10);
+			++k;
+		}
+
+		Array<char, STD::numeric_limits<Float>::max_digits10 + 1> digits{};
+		int count = 0;
+		for (;;) {
+			r.multiply(10);
+			m_low.multiply(10);
+			m_high.multiply(10);
+			// The quotient is below ten. An estimate from the leading bits is never too high.
+			auto pos = s.bit_length() > 60? s.bit_length() - 60 : 0;
+			auto estimate = STD::uint32_t(r.bits(pos) / (s.bits(pos) + 1));
+			r.subtract(s, estimate);
+			char d = '0' + estimate;
+			while (compare(r, s) >= 0) {
+				r.subtract(s);
+				++d;
+			}
+			auto cmp = compare(r, m_low);
+			bool low = even? cmp <= 0 : cmp < 0,
+			     high = reaches(r, m_high, s, even);
+			if (low && high) {
+				// Round the remainder r/s to nearest, ties to even
+				cmp = compareSum(r, r, s);
+				d += cmp > 0 || (cmp == 0 && d % 2 != 0);
+			}
+			else
+				d += high;
+			digits[count++] = d;
+			if (low || high)
+				return {digits.data(), count, k-1};
+		}
+	}
+
+#ifdef CONSTAINER_HAS_TO_CHARS
+	/**< Formats with STD::to_chars, which is faster than computing the exact digits. Leaves done false if the
+	     result does not fit into the buffer. */
+	template <typename Tokens, typename OutputIt, typename Float>
+	OutputIt formatWithToChars(OutputIt out, Float x, FloatStyle style, int precision, bool alternative, bool upper,
+	                           bool& done) {
+		char buffer[1024];
+		STD::to_chars_result result{};
+		if (style == FloatStyle::shortest)
+			result = STD::to_chars(buffer, buffer + sizeof buffer, x);
+		else
+			result = STD::to_chars(buffer, buffer + sizeof buffer, x,
+			                       style == FloatStyle::fixed? STD::chars_format::fixed : STD::chars_format::scientific,
+			                       style == FloatStyle::general? STD::max(precision, 1) - 1 : precision);
+		if (result.ec != STD::errc{})
+			return out;
+		done = true;
+		TextDecimal digits(buffer, result.ptr);
+		if (style == FloatStyle::shortest)
+			return writeShortest<Tokens>(out, digits, x);
+		return writeRounded<Tokens>(out, digits, style, precision, alternative, upper);
+	}
+#endif
+
+	template <typename Tokens, typename OutputIt, typename Float>
+	constexpr OutputIt formatShortest(OutputIt out, Float x, STD::true_type) {
+		auto d = shortestDecimal<Float>(decompose(x));
+		return writeShortest<Tokens>(out, DecimalDigits<20>(d.significand, d.exponent), x);
+	}
+	template <typename Tokens, typename OutputIt, typename Float>
+	constexpr OutputIt formatShortest(OutputIt out, Float x, STD::false_type) {
+	#ifdef CONSTAINER_HAS_TO_CHARS
+		if (!isConstantEvaluated()) {
+			bool done = false;
+			out = formatWithToChars<Tokens>(out, x, FloatStyle::shortest, 0, false, false, done);
+			if (done)
+				return out;
+		}
+	#endif
+		return writeShortest<Tokens>(out, shortestByGeneration(x), x);
+	}
+
+	/**< Writes the finite, non-negative x like printf's %e, %f and %g, or as the shortest digits that convert back
+	     to x, in fixed or scientific notation, whichever is shorter (like STD::to_chars without a format). */
+	template <typename Tokens, typename OutputIt, typename Float>
+	constexpr OutputIt formatDecimal(OutputIt out, Float x, FloatStyle style, int precision = 6,
+	                                 bool alternative = false, bool upper = false) {
+		if (x == 0)
+			return style == FloatStyle::shortest? writeShortest<Tokens>(out, DecimalDigits<1>(), x)
+			                                    : writeRounded<Tokens>(out, DecimalDigits<1>(), style, precision, alternative, upper);
+		if (style == FloatStyle::shortest)
+			return formatShortest<Tokens>(out, x, hasSchubfach<Float>{});
+	#ifdef CONSTAINER_HAS_TO_CHARS
+		if (!isConstantEvaluated()) {
+			bool done = false;
+			out = formatWithToChars<Tokens>(out, x, style, precision, alternative, upper, done);
+			if (done)
+				return out;
+		}
+	#endif
+		return writeRounded<Tokens>(out, ExactDecimal<Float>(decompose(x)), style, precision, alternative, upper);
+	}
+
+	/**< Writes the finite, non-negative x like printf's %a without the 0x prefix: a hexadecimal significand with
+	     one integral digit, which is 1 for normal and 0 for subnormal values unless rounding carried into it, and a
+	     binary exponent. Without a precision, as many digits as needed to represent x exactly are written. */
+	template <typename Tokens, typename OutputIt, typename Float>
+	constexpr OutputIt formatHexadecimal(OutputIt out, Float x, int precision = -1, bool alternative = false,
+	                                     bool upper = false) {
+		using info = FloatInfo<Float>;
+		// The fraction bits, left-aligned to a whole number of hexadecimal digits
+		constexpr int fraction_digits = (info::digits-1 + 3) / 4;
+		unsigned lead = 0;
+		STD::uint64_t fraction = 0;
+		int exponent = 0;
+		if (x != 0) {
+			constexpr auto hidden = STD::uint64_t(1) << (info::digits-1);
+			auto b = decompose(x);
+			exponent = b.exponent + info::digits-1;
+			lead = b.significand >= hidden;
+			fraction = (b.significand & ~hidden) << (4*fraction_digits - (info::digits-1));
+		}
+
+		int digits = fraction_digits;
+		if (precision < 0)
+			while (digits != 0 && (fraction >> 4*(fraction_digits - digits) & 0xF) == 0)
+				--digits;
+		else if (precision < fraction_digits) {
+			// Round half to even on the dropped bits; a carry out of the kept digits goes into the leading one.
+			int dropped = 4*(fraction_digits - precision);
+			auto kept = dropped == 64? 0 : fraction >> dropped,
+			     rest = dropped == 64? fraction : fraction - (kept << dropped),
+			     half = STD::uint64_t(1) << (dropped-1);
+			bool odd = precision == 0? lead % 2 != 0 : kept % 2 != 0;
+			if (rest > half || (rest == half && odd))
+				if (++kept >> 4*precision != 0) {
+					kept = 0;
+					++lead;
+				}
+			fraction = dropped == 64? 0 : kept << dropped;
+			digits = precision;
+		}
+
+		auto hex = Tokens::get_digits(upper);
+		*out++ = digitChar<Tokens>(lead);
+		if (digits != 0 || precision > 0 || alternative)
+			*out++ = Tokens::decimalPoint;
+		for (int i = 1; i <= digits; ++i)
+			*out++ = hex[fraction >> 4*(fraction_digits - i) & 0xF];
+		for (int i = fraction_digits; i < precision; ++i)
+			*out++ = Tokens::zero;
+
+		*out++ = upper? Tokens::upperHexp : Tokens::lowerHexp;
+		*out++ = exponent < 0? Tokens::minus : Tokens::plus;
+		unsigned e = exponent < 0? -exponent : exponent, power = 1;
+		while (power * 10 <= e)
+			power *= 10;
+		for (; power != 0; power /= 10)
+			*out++ = digitChar<Tokens>(e / power % 10);
+		return out;
+	}
+}
+
+}
@@ -37,6 +37,22 @@
 	#endif
 #endif // defined CONSTAINER_PURE_CONST
 
+#ifndef CONSTAINER_HAS_IS_CONSTANT_EVALUATED
+	#if defined __has_builtin
+		#if __has_builtin(__builtin_is_constant_evaluated)
+			#define CONSTAINER_HAS_IS_CONSTANT_EVALUATED 1
+		#endif
+	#endif
+#endif // defined CONSTAINER_HAS_IS_CONSTANT_EVALUATED
+
+#ifndef CONSTAINER_HAS_BUILTIN_BIT_CAST
+	#if defined __has_builtin
+		#if __has_builtin(__builtin_bit_cast)
+			#define CONSTAINER_HAS_BUILTIN_BIT_CAST 1
+		#endif
+	#endif
+#endif // defined CONSTAINER_HAS_BUILTIN_BIT_CAST
+
 #define CONSTAINER_DIAGNOSTIC_PUSH _Pragma("GCC diagnostic push")
 #define CONSTAINER_DIAGNOSTIC_POP  _Pragma("GCC diagnostic pop")
 #define CONSTAINER_STRINGIZE_(x) #x
@@ -93,6 +109,26 @@ constexpr auto addressof( T& t ) {
 template <typename T>
 constexpr decltype(auto) as_const(T const& obj) {return obj;}
 
+/**< Determines whether the call is part of a constant evaluation. If the implementation cannot tell,
+     this is conservatively true, so that code paths that are not constexpr-friendly are never taken. */
+constexpr bool isConstantEvaluated() {
+#ifdef CONSTAINER_HAS_IS_CONSTANT_EVALUATED
+	return __builtin_is_constant_evaluated();
+#else
+	return true;
+#endif
+}
+
+/**< A hint that *p is about to be read. No-op during constant evaluation. */
+constexpr void prefetch(void const* p) {
+#if defined __clang__ || defined __GNUG__
+	if (!isConstantEvaluated())
+		__builtin_prefetch(p);
+#else
+	(void)p;
+#endif
+}
+
 template <typename...>
 using void_t = void;
 
@@ -6,7 +6,8 @@
 
 namespace Constainer {
 
-template <typename Container>
+/**< Derived is the actual iterator type, which operator* and ++ return so that assignments reach its operator=. */
+template <typename Container, typename Derived>
 struct insert_iterator_base {
 	using container_type = Container;
 	typedef void value_type, difference_type, pointer, reference;
@@ -19,14 +20,14 @@ public:
 	constexpr insert_iterator_base(container_type& c) :
 		container(&c) {}
 
-	constexpr insert_iterator_base& operator*()     {return *this;}
-	constexpr insert_iterator_base& operator++()    {return *this;}
-	constexpr insert_iterator_base& operator++(int) {return *this;}
+	constexpr Derived& operator*()     {return static_cast<Derived&>(*this);}
+	constexpr Derived& operator++()    {return static_cast<Derived&>(*this);}
+	constexpr Derived& operator++(int) {return static_cast<Derived&>(*this);}
 };
 
 template <typename Container>
-struct back_insert_iterator : insert_iterator_base<Container> {
-	using insert_iterator_base<Container>::insert_iterator_base;
+struct back_insert_iterator : insert_iterator_base<Container, back_insert_iterator<Container>> {
+	using insert_iterator_base<Container, back_insert_iterator>::insert_iterator_base;
 	template <typename T>
 	constexpr back_insert_iterator& operator=(T&& value) {
 		this->container->push_back(STD::forward<T>(value));
@@ -34,8 +35,8 @@ struct back_insert_iterator : insert_iterator_base<Container> {
 	}
 };
 template <typename Container>
-struct front_insert_iterator : insert_iterator_base<Container> {
-	using insert_iterator_base<Container>::insert_iterator_base;
+struct front_insert_iterator : insert_iterator_base<Container, front_insert_iterator<Container>> {
+	using insert_iterator_base<Container, front_insert_iterator>::insert_iterator_base;
 	template <typename T>
 	constexpr front_insert_iterator& operator=(T&& value) {
 		this->container->push_front(STD::forward<T>(value));
@@ -43,13 +44,13 @@ struct front_insert_iterator : insert_iterator_base<Container> {
 	}
 };
 template <typename Container>
-struct insert_iterator : insert_iterator_base<Container> {
+struct insert_iterator : insert_iterator_base<Container, insert_iterator<Container>> {
 protected:
 	typename Container::iterator iter;
 
 public:
-	insert_iterator(Container& c, typename Container::iterator i) :
-		insert_iterator_base<Container>(c), iter(i) {}
+	constexpr insert_iterator(Container& c, typename Container::iterator i) :
+		insert_iterator_base<Container, insert_iterator>(c), iter(i) {}
 	template <typename T>
 	constexpr insert_iterator& operator=(T&& value) {
 		iter = ++(this->container->insert(iter, STD::forward<T>(value)));
@@ -57,4 +58,17 @@ public:
 	}
 };
 
+template <typename Container>
+constexpr back_insert_iterator<Container> back_inserter(Container& c) {
+	return back_insert_iterator<Container>(c);
+}
+template <typename Container>
+constexpr front_insert_iterator<Container> front_inserter(Container& c) {
+	return front_insert_iterator<Container>(c);
+}
+template <typename Container>
+constexpr insert_iterator<Container> inserter(Container& c, typename Container::iterator i) {
+	return insert_iterator<Container>(c, i);
+}
+
 }
@@ -0,0 +1,53 @@
+/* Copyright 2015, 2016 Robert Haberlach
+	Distributed under the Boost Software License, Version 1.0.
+	(See accompanying file LICENSE_1_0.txt or http://www.boost.org/LICENSE_1_0.txt) */
+
+#pragma once
+
+#include "Fundamental.hxx"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Constainer {
+
+/**< Element operations performed at runtime: comparisons by the flat associative containers, and copies and
+     moves by DefaultCopyTraits and by vectors making room for insertions. Only counted if
+     CONSTAINER_COUNT_OPERATIONS is defined; constant evaluation is never counted. */
+struct OperationCounts {
+	STD::uint64_t comparisons = 0;
+	STD::uint64_t copies = 0;
+	STD::uint64_t moves = 0;
+};
+
+namespace detail {
+	template <typename=void>
+	struct OperationCounter {
+		static OperationCounts counts;
+	};
+	template <typename T>
+	OperationCounts OperationCounter<T>::counts;
+
+	inline void addOperations(STD::uint64_t OperationCounts::* counter, STD::size_t n) {
+		OperationCounter<>::counts.*counter += n;
+	}
+
+	constexpr void countOperations(STD::uint64_t OperationCounts::* counter, STD::size_t n) {
+	#ifdef CONSTAINER_COUNT_OPERATIONS
+		if (!isConstantEvaluated())
+			addOperations(counter, n);
+	#else
+		(void)counter, (void)n;
+	#endif
+	}
+}
+
+/**< The counts since the last reset. */
+inline OperationCounts& operationCounts() {
+	return detail::OperationCounter<>::counts;
+}
+inline void resetOperationCounts() {
+	operationCounts() = {};
+}
+
+}